@@ -0,0 +1,139 @@
+/******************************************************************************
+ *  File: alg_adjacency_arena.h
+ *
+ *  A header file defining the arena-backed adjacency store of the mutable
+ *  Graph and Digraph classes. The neighbors of a vertex live in a chain of
+ *  blocks carved out of large pages with a bump pointer, so adding an edge
+ *  never calls malloc on its own, copying a graph copies whole pages and
+ *  destroying one frees them page by page.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_ADJACENCY_ARENA_H_
+#define _ADV_ALG_ADJACENCY_ARENA_H_
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+/******************************************************************************
+ *  Class: AdjacencyArena
+ *  Per-vertex neighbor lists in chained blocks. A vertex's blocks grow
+ *  geometrically (4, 4, 8, 16, ... up to MAX_BLOCK entries), so a list of
+ *  length d spans O(log d + d / MAX_BLOCK) blocks. Neighbors keep their
+ *  insertion order; erasing one shifts the rest of its block. Space of
+ *  erased entries is only reclaimed by reset().
+ ******************************************************************************/
+class AdjacencyArena
+{
+private:
+  static constexpr int PAGE = 1 << 16; // Entries per page
+  static constexpr int MIN_BLOCK = 4;
+  static constexpr int MAX_BLOCK = 1024;
+
+  struct Block
+  {
+    int page, offset; // Position of the entries
+    int capacity, size;
+    int next = -1; // Next block of the same vertex
+  };
+
+  struct Chain
+  {
+    int head = -1, tail = -1;
+    int size = 0;
+  };
+
+  std::vector<std::vector<int>> pages;
+  std::vector<Block> blocks;
+  std::vector<Chain> chains; // One per vertex
+
+  int allocate(int v, int capacity);
+  int *data(const Block &b) { return pages[b.page].data() + b.offset; }
+  const int *data(const Block &b) const { return pages[b.page].data() + b.offset; }
+
+public:
+  /****************************************************************************
+   *  Class: Iterator
+   *  A forward iterator over the neighbors of one vertex.
+   ****************************************************************************/
+  class Iterator
+  {
+  private:
+    const AdjacencyArena *arena = nullptr;
+    int block = -1, i = 0;
+
+    void skip_empty();
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int *;
+    using reference = int;
+
+    Iterator() = default;
+    Iterator(const AdjacencyArena *arena, int block);
+
+    int operator*() const;
+    Iterator &operator++();
+    Iterator operator++(int);
+    bool operator==(const Iterator &other) const;
+  };
+
+  /****************************************************************************
+   *  Class: Range
+   *  The neighbors of one vertex, for range-based for loops.
+   ****************************************************************************/
+  class Range
+  {
+  private:
+    const AdjacencyArena *arena;
+    int v;
+
+  public:
+    Range(const AdjacencyArena *arena, int v);
+
+    Iterator begin() const;
+    Iterator end() const;
+    int size() const;
+  };
+
+  // Constructors
+  AdjacencyArena() = default;
+  explicit AdjacencyArena(int V);
+
+  // Drops every list and page, leaving V empty lists
+  void reset(int V);
+
+  int vertices() const;
+  int size(int v) const;
+  Range operator[](int v) const;
+
+  // Adding/removing
+  void push_back(int v, int w);
+  void append(int v, std::span<const int> list); // In as few blocks as possible
+  bool erase(int v, int w);                      // First occurrence only
+  bool contains(int v, int w) const;
+
+  // Calls f(w) for every neighbor w of v, block by block
+  template <class F>
+  void for_each(int v, F &&f) const
+  {
+    for (int b = chains[v].head; b != -1; b = blocks[b].next)
+    {
+      const int *entries = data(blocks[b]);
+      for (int i = 0; i < blocks[b].size; i++)
+      {
+        f(entries[i]);
+      }
+    }
+  }
+
+  // Memory use
+  std::size_t pages_count() const;
+  std::size_t blocks_count() const;
+  std::size_t bytes() const;
+};
+
+#endif
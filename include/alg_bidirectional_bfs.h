@@ -0,0 +1,48 @@
+/******************************************************************************
+ *  File: alg_bidirectional_bfs.h
+ *
+ *  A header file defining point-to-point shortest path (fewest edges)
+ *  queries by bidirectional breadth-first search.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_BIDIRECTIONAL_BFS_H_
+#define _ADV_ALG_BIDIRECTIONAL_BFS_H_
+
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Class: BidirectionalBFS
+ *  Answers shortest_path(s, t) by growing a BFS forward from s and one
+ *  backward from t (over the in-edges, built once from reverse()), always
+ *  expanding the smaller frontier by a whole level, until they meet. This
+ *  typically visits far fewer vertices than one BFS from s.
+ *
+ *  Queries only read the graph; their scratch state (visit stamps, parents,
+ *  depths) lives in per-thread buffers that are sized once and invalidated
+ *  by bumping an epoch counter, so back-to-back queries neither allocate nor
+ *  clear O(V) memory, and several threads can query at once. The graph is a
+ *  snapshot: later changes to a Graph or Digraph are not seen.
+ ******************************************************************************/
+class BidirectionalBFS
+{
+private:
+  CSRGraph forward;
+  CSRGraph backward; // Empty for undirected graphs, which use forward
+
+  const CSRGraph &in_edges() const;
+
+public:
+  explicit BidirectionalBFS(const Graph &g);
+  explicit BidirectionalBFS(const Digraph &g);
+  explicit BidirectionalBFS(const CSRGraph &g);
+
+  // Vertices of a path with the fewest edges, from s to t; empty if there
+  // is none
+  std::vector<int> shortest_path(int s, int t) const;
+
+  // Edges on that path, or -1 if t is not reachable from s
+  int distance(int s, int t) const;
+};
+
+#endif
@@ -0,0 +1,161 @@
+/******************************************************************************
+ *  File: alg_compressed_graph.h
+ *
+ *  A header file defining a compressed, read-only graph. Every neighbor list
+ *  is sorted and stored as variable-length gaps (WebGraph-style), which
+ *  typically takes 1-4 bytes per edge, and is decoded on the fly while it is
+ *  iterated.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_COMPRESSED_GRAPH_H_
+#define _ADV_ALG_COMPRESSED_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "alg_csr.h"
+#include "alg_graphs.h"
+
+/******************************************************************************
+ *  Class: CompressedGraph
+ *  The list of v is encoded as varint(degree), zigzag(first - v) and then the
+ *  gaps between consecutive sorted neighbors, each as a little-endian base-128
+ *  varint. The byte position of a list is a 64-bit anchor per block of 64
+ *  vertices plus a 32-bit offset within the block, about 4 bytes per vertex
+ *  instead of 8. adj(v) returns a range that decodes while it is iterated,
+ *  so loops written as `for (int w : g.adj(v))` work unchanged.
+ *
+ *  It is not a BaseGraph: DepthFirstSearch needs the mutable lists of one,
+ *  so depth-first searches over a CompressedGraph go through
+ *  DepthFirstTraversal and traverse() in alg_traversal.h, which decode the
+ *  lists in place.
+ ******************************************************************************/
+class CompressedGraph
+{
+private:
+  int _V = 0;
+  long long _E = 0; // Logical number of edges
+  bool _directed = true;
+  std::vector<long long> _anchors;     // Byte position of every block
+  std::vector<std::uint32_t> _offsets; // Byte position within the block
+  std::vector<unsigned char> _bytes;
+
+  const unsigned char *list(int v) const;
+
+public:
+  static constexpr int BLOCK_BITS = 6;
+
+  static unsigned read_varint(const unsigned char *&p)
+  {
+    unsigned x = *p++;
+    if (x < 0x80)
+    {
+      return x;
+    }
+
+    x &= 0x7f;
+    for (int shift = 7;; shift += 7)
+    {
+      unsigned b = *p++;
+      x |= (b & 0x7f) << shift;
+      if (b < 0x80)
+      {
+        return x;
+      }
+    }
+  }
+
+  /****************************************************************************
+   *  Class: NeighborIterator
+   *  An input iterator decoding one neighbor list.
+   ****************************************************************************/
+  class NeighborIterator
+  {
+  private:
+    const unsigned char *p = nullptr;
+    int remaining = 0; // Neighbors left, including the current one
+    int value = 0;
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int *;
+    using reference = int;
+
+    NeighborIterator() = default;
+    NeighborIterator(const unsigned char *p, int degree, int v) : p(p), remaining(degree)
+    {
+      if (remaining > 0)
+      {
+        unsigned z = read_varint(this->p);
+        value = v + static_cast<int>((z >> 1) ^ -(z & 1));
+      }
+    }
+
+    int operator*() const { return value; }
+
+    NeighborIterator &operator++()
+    {
+      if (--remaining > 0)
+      {
+        value += static_cast<int>(read_varint(p));
+      }
+
+      return *this;
+    }
+
+    NeighborIterator operator++(int)
+    {
+      NeighborIterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const NeighborIterator &it) const { return remaining == it.remaining; }
+    bool operator!=(const NeighborIterator &it) const { return remaining != it.remaining; }
+  };
+
+  /****************************************************************************
+   *  Class: NeighborRange
+   *  The decoded neighbors of one vertex, in increasing order.
+   ****************************************************************************/
+  class NeighborRange
+  {
+  private:
+    const unsigned char *p;
+    int _size, v;
+
+  public:
+    NeighborRange(const unsigned char *p, int size, int v) : p(p), _size(size), v(v) {}
+
+    NeighborIterator begin() const { return NeighborIterator(p, _size, v); }
+    NeighborIterator end() const { return NeighborIterator(); }
+    int size() const { return _size; }
+  };
+
+  // Constructors
+  CompressedGraph() = default;
+  explicit CompressedGraph(const CSRGraph &g, int threads = 0);
+  explicit CompressedGraph(const BaseGraph &g, int threads = 0);
+
+  // Vertices and edges
+  int V() const;
+  long long E() const;
+  bool is_directed() const;
+  bool edge(int v, int w) const;
+  NeighborRange adj(int v) const;
+
+  // Degrees
+  int degree(int v) const;
+
+  // Memory
+  std::size_t bytes() const;
+  double bytes_per_edge() const;
+
+  // Decompression
+  CSRGraph to_csr() const;
+};
+
+#endif
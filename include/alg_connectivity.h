@@ -0,0 +1,60 @@
+/******************************************************************************
+ *  File: alg_connectivity.h
+ *
+ *  A header file defining an undirected graph that answers connectivity
+ *  queries incrementally, by keeping a union-find structure in sync with its
+ *  edges instead of rerunning a depth-first search after every change.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_CONNECTIVITY_H_
+#define _ADV_ALG_CONNECTIVITY_H_
+
+#include <vector>
+#include "alg_graphs.h"
+#include "alg_uf.h"
+
+/******************************************************************************
+ *  Class: ConnectedGraph
+ *  A Graph whose add_edge also unions the endpoints in a union-find, so
+ *  connected() and components_count() take near-constant time. The
+ *  union-find runs over labels rather than vertices: every vertex carries a
+ *  label, and remove_edge searches from both endpoints in lockstep. If the
+ *  searches meet, nothing changed; otherwise the side that ran out first is
+ *  a new component and its vertices move to a fresh singleton label, in
+ *  O(|side|). Abandoned labels stay in the set of the rest, so they do not
+ *  count as components. After V splits the labels run out and are
+ *  compacted from the union-find in O(V), without rescanning the edges.
+ *  Bulk changes that bypass add_edge (operator>>, GraphLoader, assignment
+ *  from another graph) rebuild everything from the edges.
+ ******************************************************************************/
+class ConnectedGraph : public Graph
+{
+private:
+  PackedPCWQuickUF uf;        // Over 2 * V labels
+  std::vector<int> label;     // By vertex
+  int next_label = 0;         // Labels from here on are unused singletons
+  std::vector<unsigned> seen; // Search marks: 2 * epoch + side
+  unsigned epoch = 0;
+
+  void rebuild();
+  void compact();
+  bool split_side(int v, int w, std::vector<int> &side);
+
+protected:
+  void adjacency_replaced() override;
+
+public:
+  // Constructors
+  explicit ConnectedGraph(int V);
+  explicit ConnectedGraph(const Graph &g);
+
+  // Adding/removing edges
+  void add_edge(int v, int w) override;
+  void remove_edge(int v, int w) override;
+
+  // Connectivity
+  bool connected(int v, int w);
+  int components_count() const;
+};
+
+#endif
@@ -0,0 +1,121 @@
+/******************************************************************************
+ *  File: alg_csr.h
+ *
+ *  A header file defining a compressed sparse row (CSR) graph. A CSRGraph is
+ *  an immutable snapshot of a Graph or Digraph: the neighbors of every vertex
+ *  sit next to each other in one array, which is what the large-scale
+ *  traversals (SCC, topological sort, ...) iterate over.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_CSR_H_
+#define _ADV_ALG_CSR_H_
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "alg_graphs.h"
+
+class MappedFile;
+
+/******************************************************************************
+ *  Struct: BinaryGraphHeader
+ *  The first 64 bytes of a binary graph file. They are followed by
+ *  offsets (int64[V + 1]), targets (int32[arcs]) and, if flagged, the
+ *  in-degrees (int32[V]), each at the byte position recorded here. Values
+ *  are stored in the byte order of the machine that wrote the file.
+ ******************************************************************************/
+struct BinaryGraphHeader
+{
+  static constexpr char MAGIC[8] = {'A', 'L', 'G', 'G', 'R', 'A', 'P', 'H'};
+  static constexpr std::uint32_t VERSION = 1;
+  static constexpr std::uint32_t DIRECTED = 1;
+  static constexpr std::uint32_t HAS_INDEGREE = 2;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t flags;
+  std::int64_t V, E, arcs;
+  std::int64_t offsets_at, targets_at, indegree_at; // Byte positions
+};
+
+static_assert(sizeof(BinaryGraphHeader) == 64, "BinaryGraphHeader must stay 64 bytes");
+
+/******************************************************************************
+ *  Class: CSRGraph
+ *  A read-only adjacency array. The neighbors of v are
+ *  targets[offsets[v] .. offsets[v + 1]). Undirected graphs store each edge
+ *  in both directions, so arcs() == 2 * E() for them. The arrays are either
+ *  owned or, for graphs returned by load_binary, a view into a mapped file.
+ ******************************************************************************/
+class CSRGraph
+{
+private:
+  int _V = 0;
+  long long _E = 0; // Logical number of edges
+  bool _directed = true;
+  std::vector<long long> _offset_store = {0};
+  std::vector<int> _target_store;
+  std::shared_ptr<const MappedFile> _mapping; // Backs the view, if any
+  const long long *_offsets = nullptr;
+  const int *_targets = nullptr;
+  const int *_indegree = nullptr; // Stored in-degrees of a view, if any
+
+  void validate_vertex(int v) const;
+  void attach();
+
+public:
+  // Constructors
+  CSRGraph();
+  explicit CSRGraph(const BaseGraph &g);
+  CSRGraph(int V, std::vector<long long> offsets, std::vector<int> targets, bool directed);
+
+  static CSRGraph from_edges(int V, const std::vector<std::pair<int, int>> &edges, bool directed);
+
+  // Copy constructor and assignment operator
+  CSRGraph(const CSRGraph &g);
+  CSRGraph &operator=(const CSRGraph &g);
+
+  // Move constructor and assignment operator
+  CSRGraph(CSRGraph &&g) noexcept;
+  CSRGraph &operator=(CSRGraph &&g) noexcept;
+
+  // Vertices and edges
+  int V() const;
+  long long E() const;
+  long long arcs() const;
+  bool is_directed() const;
+  bool is_view() const;
+  bool edge(int v, int w) const;
+  std::span<const int> adj(int v) const;
+
+  // Degrees
+  int degree(int v) const;
+  std::vector<int> in_degrees() const;
+
+  // Raw arrays
+  std::span<const long long> offsets() const;
+  std::span<const int> targets() const;
+
+  // Reversing
+  CSRGraph transpose() const;
+
+  // Binary files. load_binary checks the header and section bounds in
+  // O(1) and otherwise trusts the file: adj() of a corrupt file may read
+  // outside the mapping. Pass verify (or call validate()) for untrusted files
+  void save_binary(const std::string &path, bool with_indegree = true) const;
+  static CSRGraph load_binary(const std::string &path, bool verify = false);
+
+  // Checks that the offsets are monotonic and every target is a vertex, in
+  // O(V + E); throws a runtime_error otherwise
+  void validate() const;
+
+  // Input/output
+  std::string str() const;
+  friend std::ostream &operator<<(std::ostream &out, const CSRGraph &g);
+};
+
+#endif
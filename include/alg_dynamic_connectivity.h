@@ -0,0 +1,69 @@
+/******************************************************************************
+ *  File: alg_dynamic_connectivity.h
+ *
+ *  A header file defining offline dynamic connectivity: a timeline of edge
+ *  inserts, deletes and connectivity queries on an undirected graph,
+ *  answered all at once after the timeline is known.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_DYNAMIC_CONNECTIVITY_H_
+#define _ADV_ALG_DYNAMIC_CONNECTIVITY_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "alg_hash.h"
+#include "alg_uf.h"
+
+/******************************************************************************
+ *  Class: OfflineDynamicConnectivity
+ *  Records add_edge, remove_edge and query calls, then solve() answers the
+ *  queries in O((V + Q + M log Q) log V) for M edge insertions and Q
+ *  queries. Each edge is alive over a range of queries; the ranges are
+ *  spread over a segment tree on the queries, which a depth-first walk
+ *  visits with a RollbackUF, unioning the edges of a node on the way down
+ *  and rolling them back on the way up. Parallel edges are counted, so an
+ *  edge added twice needs two removals.
+ ******************************************************************************/
+class OfflineDynamicConnectivity
+{
+private:
+  struct Interval
+  {
+    int v, w;
+    int from, to; // Alive for queries [from, to)
+  };
+
+  int _V;
+  std::vector<Interval> intervals;          // Closed by remove_edge
+  std::vector<std::pair<int, int>> queries; // Vertex pairs, in order
+  FlatHashMap<std::uint64_t, int> live;     // Edge -> its list in starts
+  std::vector<std::vector<int>> starts;     // When each live copy was added
+  std::vector<char> answers;
+  std::vector<int> components;
+
+  void validate_vertex(int v) const;
+  static std::uint64_t key(int v, int w);
+  void solve(int node, int lo, int hi, const std::vector<std::vector<int>> &tree,
+             const std::vector<Interval> &all, RollbackUF &uf);
+
+public:
+  explicit OfflineDynamicConnectivity(int V);
+
+  int V() const;
+  int queries_count() const;
+
+  // The timeline
+  void add_edge(int v, int w);
+  void remove_edge(int v, int w);
+  int query(int v, int w); // Returns the index of the query
+
+  // Answers every query recorded so far
+  void solve();
+
+  // Answers, after solve()
+  bool connected(int query) const;
+  int components_count(int query) const;
+};
+
+#endif
@@ -0,0 +1,68 @@
+/******************************************************************************
+ *  File: alg_dynamic_graph.h
+ *
+ *  A header file defining a mutable graph built for streams of edge
+ *  insertions and deletions.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_DYNAMIC_GRAPH_H_
+#define _ADV_ALG_DYNAMIC_GRAPH_H_
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include "alg_csr.h"
+#include "alg_hash.h"
+
+/******************************************************************************
+ *  Class: DynamicGraph
+ *  A simple graph (no parallel edges) whose neighbor lists are unordered
+ *  vectors. A hash index maps every arc v->w to its position in the list of
+ *  v, so a deletion moves the last neighbor into the hole and fixes its
+ *  index entry: O(1) expected per update instead of O(degree).
+ ******************************************************************************/
+class DynamicGraph
+{
+private:
+  int _V = 0;
+  long long _E = 0;
+  bool _directed = false;
+  std::vector<std::vector<int>> _adj;
+  FlatHashMap<std::uint64_t, int> position; // Arc v->w -> index in _adj[v]
+
+  static std::uint64_t key(int v, int w);
+  void validate_vertex(int v) const;
+  bool add_arc(int v, int w);
+  bool remove_arc(int v, int w);
+  long long apply_arcs(const std::vector<std::pair<int, int>> &edges, bool insert);
+
+public:
+  // Constructors
+  explicit DynamicGraph(int V, bool directed = false);
+  explicit DynamicGraph(const CSRGraph &g);
+
+  // Vertices and edges
+  int V() const;
+  long long E() const;
+  bool is_directed() const;
+  bool edge(int v, int w) const;
+  std::span<const int> adj(int v) const;
+
+  // Degrees
+  int degree(int v) const;
+
+  // Adding/removing; false when the edge already exists / does not exist
+  bool add_edge(int v, int w);
+  bool remove_edge(int v, int w);
+
+  // Applies all deletions, then all insertions, grouped by source vertex.
+  // Endpoints are validated once up front; nothing changes if any is out of
+  // range. Returns the number of edges actually removed plus inserted.
+  long long apply_batch(const std::vector<std::pair<int, int>> &inserts,
+                        const std::vector<std::pair<int, int>> &deletes);
+
+  CSRGraph to_csr() const;
+};
+
+#endif
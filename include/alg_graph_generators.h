@@ -0,0 +1,67 @@
+/******************************************************************************
+ *  File: alg_graph_generators.h
+ *
+ *  A header file defining synthetic graph generators for scaling tests:
+ *  R-MAT (Kronecker), Erdos-Renyi G(n, p) and G(n, m), 2D grids and chains.
+ *  Work is cut into fixed-size chunks, each with its own random stream
+ *  derived from the seed and the chunk number, so the same seed gives the
+ *  same graph whatever the number of threads.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_GRAPH_GENERATORS_H_
+#define _ADV_ALG_GRAPH_GENERATORS_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Struct: GeneratedGraph
+ *  An edge list with its vertex count, ready to become a CSRGraph, to fill
+ *  an empty Graph or Digraph, or to be written as a binary graph file.
+ ******************************************************************************/
+struct GeneratedGraph
+{
+  int V = 0;
+  bool directed = false;
+  std::vector<std::pair<int, int>> edges;
+
+  CSRGraph to_csr() const;
+  void fill(BaseGraph &g) const;
+  void save_binary(const std::string &path) const;
+};
+
+/******************************************************************************
+ *  Class: GraphGenerator
+ *  Seeded, multi-threaded generators.
+ ******************************************************************************/
+class GraphGenerator
+{
+public:
+  // R-MAT on 2^scale vertices: every edge descends `scale` levels of the
+  // adjacency matrix, picking a quadrant with probabilities a, b, c and
+  // 1 - a - b - c (Graph500 defaults). Vertex numbers are scrambled so hubs
+  // are not all small numbers. Self-loops and parallel edges are kept.
+  static GeneratedGraph rmat(int scale, long long edges, std::uint64_t seed, bool directed = false, int threads = 0,
+                             double a = 0.57, double b = 0.19, double c = 0.19);
+
+  // Every possible edge (no self-loops) independently with probability p,
+  // drawn with geometric skips in O(V + E) time
+  static GeneratedGraph gnp(int V, double p, std::uint64_t seed, bool directed = false, int threads = 0);
+
+  // Exactly `edges` distinct edges (no self-loops), uniformly at random,
+  // sorted. Each round draws the missing edges and drops duplicates with a
+  // parallel sort by source range.
+  static GeneratedGraph gnm(int V, long long edges, std::uint64_t seed, bool directed = false, int threads = 0);
+
+  // rows x cols lattice; vertex r * cols + c links to its right and lower
+  // neighbors
+  static GeneratedGraph grid(int rows, int cols, bool directed = false, int threads = 0);
+
+  // 0 - 1 - ... - (V - 1), the deepest possible DFS
+  static GeneratedGraph chain(int V, bool directed = false);
+};
+
+#endif
@@ -0,0 +1,65 @@
+/******************************************************************************
+ *  File: alg_graph_io.h
+ *
+ *  A header file defining fast graph file loaders. Files are memory-mapped
+ *  and parsed in place, optionally by several threads working on
+ *  line-aligned chunks, and the adjacency arrays are sized exactly before a
+ *  single edge is stored.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_GRAPH_IO_H_
+#define _ADV_ALG_GRAPH_IO_H_
+
+#include <cstddef>
+#include <string>
+#include "alg_csr.h"
+#include "alg_graphs.h"
+
+/******************************************************************************
+ *  Class: MappedFile
+ *  A read-only memory mapping of a whole file, unmapped on destruction.
+ ******************************************************************************/
+class MappedFile
+{
+private:
+  const char *_data = nullptr;
+  std::size_t _size = 0;
+
+public:
+  // Sequential mappings ask the kernel for aggressive read-ahead
+  explicit MappedFile(const std::string &path, bool sequential = true);
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data() const;
+  std::size_t size() const;
+
+  ~MappedFile() noexcept;
+};
+
+/******************************************************************************
+ *  Class: GraphLoader
+ *  Loads the two text formats used under resources/:
+ *    - adjacency lists: a line with V, then lines "v: w1 w2 ..." (the format
+ *      written by operator<<; lines without a colon are skipped),
+ *    - algs4 edge lists: V, E, then one "v w" pair per line (anything after
+ *      the pair on a line, such as a weight, is ignored).
+ *  Adjacency lists keep the file order of every line. With more than one
+ *  thread, the neighbors of a vertex listed on several lines (or in an edge
+ *  list) may come out in a different order.
+ ******************************************************************************/
+class GraphLoader
+{
+public:
+  static CSRGraph load_adjacency(const std::string &path, bool directed, int threads = 0);
+  static CSRGraph load_edge_list(const std::string &path, bool directed, int threads = 0);
+
+  // Fills an empty Graph or Digraph from an adjacency-list file in bulk
+  static void load(const std::string &path, BaseGraph &g, int threads = 0);
+
+  // Fills an empty Graph or Digraph (matching csr.is_directed()) in bulk
+  static void fill(const CSRGraph &csr, BaseGraph &g);
+};
+
+#endif
@@ -17,6 +17,8 @@
 #include <list>
 #include <stack>
 #include <cassert>
+#include "alg_adjacency_arena.h"
+#include "alg_traversal.h"
 
 /******************************************************************************
  *  Class: BaseGraph
@@ -27,10 +29,18 @@ class BaseGraph
 {
 protected:
   int _V = 0, _E = 0; // Number of vertices and edges
-  std::list<int> *_adj = nullptr;
+  AdjacencyArena _adj;
   void validate_vertex(int v) const;
   void copy_graph(const BaseGraph &g);
 
+  // Called after _adj was replaced as a whole (input, loaders, assignment)
+  // rather than edge by edge, for subclasses that keep state derived from
+  // the edges
+  virtual void adjacency_replaced() {}
+
+  friend class CSRGraph;
+  friend class GraphLoader;
+
 public:
   // Constructors
   BaseGraph() = default;
@@ -50,6 +60,7 @@ public:
   int E() const;
   bool edge(int v, int w) const;
   std::list<int> adj(int v) const;
+  AdjacencyArena::Range neighbors(int v) const; // Same order, no copy
 
   virtual bool is_directed() const = 0;
 
@@ -65,6 +76,9 @@ public:
   friend std::ostream &operator<<(std::ostream &out, const BaseGraph &g);
   friend std::istream &operator>>(std::istream &in, BaseGraph &g);
 
+  // Writes the binary format read by CSRGraph::load_binary
+  void save_binary(const std::string &path) const;
+
   // Clean up
   virtual ~BaseGraph() noexcept;
 };
@@ -107,6 +121,8 @@ class Digraph : public BaseGraph
 private:
   int *indegree = nullptr;
 
+  friend class GraphLoader;
+
 public:
   // Constructors
   Digraph() = default;
@@ -121,6 +137,7 @@ public:
   Digraph &operator=(Digraph &&) noexcept;
 
   // Vertices and edges
+  using BaseGraph::V;
   void V(int v) override;
   bool is_directed() const override;
 
@@ -167,6 +184,10 @@ private:
   int time = 0;
   int c_count = 0; // Components count
   std::list<int> pre, post;
+  bool directed;
+  DepthFirstTraversal<BaseGraph> traversal;
+
+  struct Recorder; // The traversal visitor filling the attributes
 
 public:
   DepthFirstSearch(BaseGraph &g);
@@ -0,0 +1,330 @@
+/******************************************************************************
+ *  File: alg_hash.h
+ *
+ *  A header file defining open-addressing hash containers for integer keys.
+ *  They use linear probing and backward-shift deletion, so there are no
+ *  tombstones and lookups stay short under heavy insert/erase traffic.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_HASH_H_
+#define _ADV_ALG_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/******************************************************************************
+ *  Function: hash_mix
+ *  A 64-bit finalizer (from splitmix64) spreading consecutive keys apart.
+ ******************************************************************************/
+inline std::uint64_t hash_mix(std::uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/******************************************************************************
+ *  Class: FlatHashSet
+ *  A set of integer keys; Key(-1) marks an empty slot and cannot be stored.
+ ******************************************************************************/
+template <class Key>
+class FlatHashSet
+{
+private:
+  static constexpr Key EMPTY = static_cast<Key>(-1);
+  std::vector<Key> slots;
+  std::size_t _size = 0;
+  std::size_t mask = 0;
+
+  std::size_t home(Key k) const
+  {
+    return static_cast<std::size_t>(hash_mix(static_cast<std::uint64_t>(k))) & mask;
+  }
+
+  void rehash(std::size_t capacity)
+  {
+    std::vector<Key> old;
+    old.swap(slots);
+    slots.assign(capacity, EMPTY);
+    mask = capacity - 1;
+    for (Key k : old)
+    {
+      if (k != EMPTY)
+      {
+        std::size_t i = home(k);
+        while (slots[i] != EMPTY)
+        {
+          i = (i + 1) & mask;
+        }
+        slots[i] = k;
+      }
+    }
+  }
+
+public:
+  FlatHashSet() { rehash(8); }
+
+  std::size_t size() const { return _size; }
+
+  bool contains(Key k) const
+  {
+    if (k == EMPTY)
+    {
+      return false;
+    }
+
+    for (std::size_t i = home(k);; i = (i + 1) & mask)
+    {
+      if (slots[i] == k)
+      {
+        return true;
+      }
+
+      if (slots[i] == EMPTY)
+      {
+        return false;
+      }
+    }
+  }
+
+  bool insert(Key k)
+  {
+    if (k == EMPTY)
+    {
+      throw std::runtime_error("The empty-slot key cannot be stored");
+    }
+
+    if (8 * (_size + 1) > 7 * slots.size())
+    {
+      rehash(2 * slots.size());
+    }
+
+    std::size_t i = home(k);
+    for (; slots[i] != EMPTY; i = (i + 1) & mask)
+    {
+      if (slots[i] == k)
+      {
+        return false;
+      }
+    }
+
+    slots[i] = k;
+    _size++;
+    return true;
+  }
+
+  bool erase(Key k)
+  {
+    if (k == EMPTY)
+    {
+      return false;
+    }
+
+    std::size_t i = home(k);
+    for (; slots[i] != k; i = (i + 1) & mask)
+    {
+      if (slots[i] == EMPTY)
+      {
+        return false;
+      }
+    }
+
+    // Shift later members of the probe run back into the hole
+    for (std::size_t j = (i + 1) & mask; slots[j] != EMPTY; j = (j + 1) & mask)
+    {
+      std::size_t h = home(slots[j]);
+      if (((j - h) & mask) >= ((j - i) & mask))
+      {
+        slots[i] = slots[j];
+        i = j;
+      }
+    }
+
+    slots[i] = EMPTY;
+    _size--;
+    return true;
+  }
+
+  template <class F>
+  void for_each(F &&f) const
+  {
+    for (Key k : slots)
+    {
+      if (k != EMPTY)
+      {
+        f(k);
+      }
+    }
+  }
+};
+
+/******************************************************************************
+ *  Class: FlatHashMap
+ *  A map from integer keys to small values; Key(-1) marks an empty slot and
+ *  cannot be stored.
+ ******************************************************************************/
+template <class Key, class Value>
+class FlatHashMap
+{
+private:
+  static constexpr Key EMPTY = static_cast<Key>(-1);
+
+  struct Slot
+  {
+    Key key;
+    Value value;
+  };
+
+  std::vector<Slot> slots;
+  std::size_t _size = 0;
+  std::size_t mask = 0;
+
+  std::size_t home(Key k) const
+  {
+    return static_cast<std::size_t>(hash_mix(static_cast<std::uint64_t>(k))) & mask;
+  }
+
+  void rehash(std::size_t capacity)
+  {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(capacity, Slot{EMPTY, Value()});
+    mask = capacity - 1;
+    for (const Slot &s : old)
+    {
+      if (s.key != EMPTY)
+      {
+        std::size_t i = home(s.key);
+        while (slots[i].key != EMPTY)
+        {
+          i = (i + 1) & mask;
+        }
+        slots[i] = s;
+      }
+    }
+  }
+
+public:
+  FlatHashMap() { rehash(8); }
+
+  std::size_t size() const { return _size; }
+
+  // Makes room for n keys without further rehashing
+  void reserve(std::size_t n)
+  {
+    std::size_t capacity = slots.size();
+    while (7 * capacity < 8 * n)
+    {
+      capacity *= 2;
+    }
+
+    if (capacity != slots.size())
+    {
+      rehash(capacity);
+    }
+  }
+
+  // Returns the value of k, or nullptr if k is absent
+  Value *find(Key k)
+  {
+    if (k == EMPTY)
+    {
+      return nullptr;
+    }
+
+    for (std::size_t i = home(k);; i = (i + 1) & mask)
+    {
+      if (slots[i].key == k)
+      {
+        return &slots[i].value;
+      }
+
+      if (slots[i].key == EMPTY)
+      {
+        return nullptr;
+      }
+    }
+  }
+
+  const Value *find(Key k) const
+  {
+    return const_cast<FlatHashMap *>(this)->find(k);
+  }
+
+  // Adds k with value v; returns false (and changes nothing) if k exists
+  bool insert(Key k, const Value &v)
+  {
+    if (k == EMPTY)
+    {
+      throw std::runtime_error("The empty-slot key cannot be stored");
+    }
+
+    if (8 * (_size + 1) > 7 * slots.size())
+    {
+      rehash(2 * slots.size());
+    }
+
+    std::size_t i = home(k);
+    for (; slots[i].key != EMPTY; i = (i + 1) & mask)
+    {
+      if (slots[i].key == k)
+      {
+        return false;
+      }
+    }
+
+    slots[i] = Slot{k, v};
+    _size++;
+    return true;
+  }
+
+  bool erase(Key k)
+  {
+    if (k == EMPTY)
+    {
+      return false;
+    }
+
+    std::size_t i = home(k);
+    for (; slots[i].key != k; i = (i + 1) & mask)
+    {
+      if (slots[i].key == EMPTY)
+      {
+        return false;
+      }
+    }
+
+    for (std::size_t j = (i + 1) & mask; slots[j].key != EMPTY; j = (j + 1) & mask)
+    {
+      std::size_t h = home(slots[j].key);
+      if (((j - h) & mask) >= ((j - i) & mask))
+      {
+        slots[i] = slots[j];
+        i = j;
+      }
+    }
+
+    slots[i].key = EMPTY;
+    _size--;
+    return true;
+  }
+
+  template <class F>
+  void for_each(F &&f) const
+  {
+    for (const Slot &s : slots)
+    {
+      if (s.key != EMPTY)
+      {
+        f(s.key, s.value);
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,117 @@
+/******************************************************************************
+ *  File: alg_hybrid_graph.h
+ *
+ *  A header file defining a mutable graph tuned for edge queries and removals
+ *  on skewed (power-law) degree distributions.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_HYBRID_GRAPH_H_
+#define _ADV_ALG_HYBRID_GRAPH_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "alg_csr.h"
+#include "alg_hash.h"
+
+enum class AdjacencyMode
+{
+  Hybrid,     // Small vectors, hubs promoted to hash sets
+  DenseBitmap // One adjacency-matrix bit per vertex pair
+};
+
+/******************************************************************************
+ *  Class: HybridGraph
+ *  A simple graph (no parallel edges) with one of two adjacency policies:
+ *    - Hybrid: every vertex keeps its neighbors in a small contiguous vector
+ *      (scanned linearly) until its degree passes hub_threshold. It is then
+ *      promoted to a hash set, giving O(1) edge(), add_edge() and
+ *      remove_edge() for hubs.
+ *    - DenseBitmap: a V x V bit matrix for small dense graphs; every query
+ *      and update is a single bit operation. The matrix takes V * V / 8
+ *      bytes, so above MAX_DENSE_VERTICES vertices the graph stays Hybrid
+ *      instead; mode() tells which policy is in use.
+ *
+ *  It is a separate class rather than the storage of Graph and Digraph:
+ *  those are multigraphs whose adjacency lists keep insertion order, which
+ *  the algorithms built on BaseGraph rely on, so their edge() and
+ *  remove_edge() stay O(degree). Graphs that need O(1) hub queries are built
+ *  as a HybridGraph, from scratch or from a CSRGraph snapshot.
+ ******************************************************************************/
+class HybridGraph
+{
+private:
+  struct Neighbors
+  {
+    std::vector<int> small;
+    std::unique_ptr<FlatHashSet<int>> hub;
+  };
+
+  int _V = 0;
+  long long _E = 0;
+  bool _directed = false;
+  AdjacencyMode _mode = AdjacencyMode::Hybrid;
+  int hub_threshold = 64;
+
+  std::vector<Neighbors> lists;      // Hybrid mode
+  std::vector<std::uint64_t> matrix; // DenseBitmap mode
+  std::vector<int> degrees;          // DenseBitmap mode
+  long long row_words = 0;
+
+  void validate_vertex(int v) const;
+  bool has_arc(int v, int w) const;
+  bool add_arc(int v, int w);
+  bool remove_arc(int v, int w);
+
+public:
+  static constexpr int MAX_DENSE_VERTICES = 1 << 16; // A 512 MiB matrix
+
+  // Constructors
+  explicit HybridGraph(int V, bool directed = false, AdjacencyMode mode = AdjacencyMode::Hybrid, int hub_threshold = 64);
+  explicit HybridGraph(const CSRGraph &g, AdjacencyMode mode = AdjacencyMode::Hybrid, int hub_threshold = 64);
+
+  // Vertices and edges
+  int V() const;
+  long long E() const;
+  bool is_directed() const;
+  AdjacencyMode mode() const;
+  bool is_hub(int v) const;
+  bool edge(int v, int w) const;
+  std::vector<int> adj(int v) const;
+
+  template <class F>
+  void for_each_adj(int v, F &&f) const
+  {
+    if (_mode == AdjacencyMode::DenseBitmap)
+    {
+      const std::uint64_t *row = matrix.data() + v * row_words;
+      for (long long i = 0; i < row_words; i++)
+      {
+        for (std::uint64_t bits = row[i]; bits != 0; bits &= bits - 1)
+        {
+          f(static_cast<int>(i * 64 + __builtin_ctzll(bits)));
+        }
+      }
+    }
+    else if (lists[v].hub != nullptr)
+    {
+      lists[v].hub->for_each(f);
+    }
+    else
+    {
+      for (int w : lists[v].small)
+      {
+        f(w);
+      }
+    }
+  }
+
+  // Degrees
+  int degree(int v) const;
+
+  // Adding/removing; false when the edge already exists / does not exist
+  bool add_edge(int v, int w);
+  bool remove_edge(int v, int w);
+};
+
+#endif
@@ -0,0 +1,70 @@
+/******************************************************************************
+ *  File: alg_mst.h
+ *
+ *  A header file defining minimum spanning forest (MSF) classes for
+ *  undirected edge-weighted graphs. Ties between equal weights are broken by
+ *  the position of the edge in g.edges(), so every class returns the same
+ *  forest. Weights are integers (EdgeWeightedGraph), which the radix sort
+ *  of KruskalMST relies on.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_MST_H_
+#define _ADV_ALG_MST_H_
+
+#include <vector>
+#include "alg_weighted_graphs.h"
+
+/******************************************************************************
+ *  Class: MinimumSpanningForest
+ *  A base class holding the forest: its edges and their total weight.
+ ******************************************************************************/
+class MinimumSpanningForest
+{
+protected:
+  std::vector<WeightedEdge> _edges;
+  long long _weight = 0;
+
+  explicit MinimumSpanningForest(const EdgeWeightedGraph &g);
+  void add(const WeightedEdge &e);
+
+public:
+  long long weight() const;
+  const std::vector<WeightedEdge> &edges() const;
+
+  virtual ~MinimumSpanningForest() noexcept;
+};
+
+/******************************************************************************
+ *  Class: KruskalMST
+ *  Kruskal's algorithm: the edges are put in weight order with a parallel,
+ *  stable LSD radix sort (one pass per significant byte of the largest
+ *  weight), then joined with a PCWQuickUF.
+ ******************************************************************************/
+class KruskalMST : public MinimumSpanningForest
+{
+public:
+  explicit KruskalMST(const EdgeWeightedGraph &g, int threads = 0);
+};
+
+/******************************************************************************
+ *  Class: BoruvkaMST
+ *  A parallel Boruvka algorithm. Every round, each component picks its
+ *  lightest outgoing edge in one parallel scan, the picked edges are joined
+ *  in parallel with a ConcurrentUF, every vertex is relabeled by its new
+ *  root in parallel, and edges that now sit inside one component are
+ *  filtered out, so later rounds scan ever fewer edges. At most log2(V)
+ *  rounds are needed. The joining and relabeling passes still cover all V
+ *  vertices every round; only appending the round's forest edges is serial.
+ ******************************************************************************/
+class BoruvkaMST : public MinimumSpanningForest
+{
+private:
+  int _rounds = 0;
+
+public:
+  explicit BoruvkaMST(const EdgeWeightedGraph &g, int threads = 0);
+
+  int rounds() const;
+};
+
+#endif
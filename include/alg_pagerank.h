@@ -0,0 +1,61 @@
+/******************************************************************************
+ *  File: alg_pagerank.h
+ *
+ *  A header file defining a pull-based (personalized) PageRank engine for
+ *  directed graphs. It is instantiated for float and double rank vectors.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_PAGERANK_H_
+#define _ADV_ALG_PAGERANK_H_
+
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Struct: PageRankOptions
+ *  Tuning knobs of a PageRank run. Iterations stop once the L1 distance
+ *  between two consecutive rank vectors drops below the tolerance.
+ ******************************************************************************/
+struct PageRankOptions
+{
+  double damping = 0.85;
+  double tolerance = 1e-6;
+  int max_iterations = 100;
+  int threads = 0;
+};
+
+/******************************************************************************
+ *  Class: PageRank
+ *  Every iteration, each vertex pulls the contributions (rank / out-degree)
+ *  of its in-neighbors from the transposed graph, built once. A vertex only
+ *  writes its own rank, so iterations need no locks or atomics. The rank
+ *  mass of dangling vertices (no out-edges) and the teleport jumps are
+ *  spread following the personalization vector (uniform by default).
+ ******************************************************************************/
+template <class Real>
+class PageRank
+{
+private:
+  CSRGraph in_edges; // Transpose of the graph
+  std::vector<int> out_degree;
+  PageRankOptions options;
+  std::vector<Real> _ranks;
+  int _iterations = 0;
+  double _residual = 0;
+
+public:
+  explicit PageRank(const Digraph &g, const PageRankOptions &options = {});
+  explicit PageRank(const CSRGraph &g, const PageRankOptions &options = {});
+
+  // Recomputes the ranks, reusing the transposed graph. The personalization
+  // gives a non-negative teleport weight per vertex; empty means uniform.
+  void run(const std::vector<double> &personalization = {});
+
+  const std::vector<Real> &ranks() const;
+  Real rank(int v) const;
+  int iterations() const;
+  double residual() const;
+  bool converged() const;
+};
+
+#endif
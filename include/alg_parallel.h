@@ -0,0 +1,125 @@
+/******************************************************************************
+ *  File: alg_parallel.h
+ *
+ *  A header file of small threading helpers shared by the parallel graph and
+ *  union-find algorithms. Work is split into chunks that threads grab from an
+ *  atomic counter, which gives dynamic scheduling without a thread pool.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_PARALLEL_H_
+#define _ADV_ALG_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/******************************************************************************
+ *  Function: resolve_threads
+ *  Maps a requested thread count to an actual one. Zero or negative means
+ *  "use every hardware thread".
+ ******************************************************************************/
+inline int resolve_threads(int threads)
+{
+  if (threads > 0)
+  {
+    return threads;
+  }
+
+  int hw = static_cast<int>(std::thread::hardware_concurrency());
+  return hw > 0 ? hw : 1;
+}
+
+/******************************************************************************
+ *  Function: parallel_run
+ *  Calls fn(tid) once on each of `threads` threads (the caller being thread 0)
+ *  and waits for all of them to finish.
+ ******************************************************************************/
+template <class F>
+void parallel_run(int threads, F &&fn)
+{
+  threads = resolve_threads(threads);
+  if (threads == 1)
+  {
+    fn(0);
+    return;
+  }
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (int t = 1; t < threads; t++)
+  {
+    pool.emplace_back([&fn, t]()
+                      { fn(t); });
+  }
+
+  fn(0);
+  for (std::thread &th : pool)
+  {
+    th.join();
+  }
+}
+
+/******************************************************************************
+ *  Function: parallel_chunks
+ *  Splits [begin, end) into chunks of `grain` indices and calls
+ *  fn(tid, lo, hi) for each chunk. Threads grab the next chunk from a shared
+ *  counter, so uneven per-index work (e.g. skewed vertex degrees) is balanced.
+ *  Ranges no larger than one grain run on the calling thread only.
+ ******************************************************************************/
+template <class F>
+void parallel_chunks(long long begin, long long end, F &&fn, int threads = 0, long long grain = 1024)
+{
+  if (end <= begin)
+  {
+    return;
+  }
+
+  threads = resolve_threads(threads);
+  if (grain < 1)
+  {
+    grain = 1;
+  }
+
+  if (threads == 1 || end - begin <= grain)
+  {
+    fn(0, begin, end);
+    return;
+  }
+
+  long long chunks = (end - begin + grain - 1) / grain;
+  threads = static_cast<int>(std::min<long long>(threads, chunks));
+
+  std::atomic<long long> next(begin);
+  parallel_run(threads, [&](int tid)
+               {
+    for (;;)
+    {
+      long long lo = next.fetch_add(grain, std::memory_order_relaxed);
+      if (lo >= end)
+      {
+        break;
+      }
+
+      fn(tid, lo, std::min(lo + grain, end));
+    } });
+}
+
+/******************************************************************************
+ *  Function: parallel_for
+ *  Calls fn(i) for every i in [begin, end), scheduled like parallel_chunks.
+ ******************************************************************************/
+template <class F>
+void parallel_for(long long begin, long long end, F &&fn, int threads = 0, long long grain = 1024)
+{
+  parallel_chunks(
+      begin, end, [&fn](int, long long lo, long long hi)
+      {
+        for (long long i = lo; i < hi; i++)
+        {
+          fn(i);
+        } },
+      threads, grain);
+}
+
+#endif
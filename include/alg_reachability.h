@@ -0,0 +1,67 @@
+/******************************************************************************
+ *  File: alg_reachability.h
+ *
+ *  A header file defining batched reachability tools for directed graphs:
+ *  a bit-parallel multi-source BFS, and a precomputed 2-hop label index for
+ *  answering single "is t reachable from s" queries without a traversal.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_REACHABILITY_H_
+#define _ADV_ALG_REACHABILITY_H_
+
+#include <cstdint>
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Class: MultiSourceBFS
+ *  Runs one breadth-first search per source, up to 256 of them at a time.
+ *  Every vertex carries one bit per source in the batch, so a single scan of
+ *  an edge advances all the searches that reached its tail.
+ ******************************************************************************/
+class MultiSourceBFS
+{
+private:
+  int _V;
+  std::vector<int> _sources;
+  std::vector<std::uint64_t> seen; // Per batch: V x words bitsets, vertex-major
+  int threads;
+
+  template <int W>
+  void run_batch(const CSRGraph &g, int first, int count, std::uint64_t *out);
+
+public:
+  static constexpr int BATCH = 256; // Sources per traversal
+
+  MultiSourceBFS(const CSRGraph &g, const std::vector<int> &sources, int threads = 0);
+
+  int sources_count() const;
+  // Whether v is reachable from the i-th source
+  bool reachable(int i, int v) const;
+};
+
+/******************************************************************************
+ *  Class: ReachabilityIndex
+ *  A pruned 2-hop labeling of the condensation DAG. Every component gets an
+ *  out-label and an in-label (lists of landmark ranks); t is reachable from
+ *  s exactly when the out-label of s and the in-label of t share a landmark.
+ *  Landmarks are taken in decreasing degree order, so hubs cover most pairs
+ *  and the labels stay short.
+ ******************************************************************************/
+class ReachabilityIndex
+{
+private:
+  std::vector<int> component;                // SCC of every vertex
+  std::vector<long long> out_offsets, in_offsets;
+  std::vector<int> out_labels, in_labels; // Sorted landmark ranks
+
+  static bool intersect(const int *a, const int *a_end, const int *b, const int *b_end);
+
+public:
+  explicit ReachabilityIndex(const CSRGraph &g);
+
+  bool reachable(int s, int t) const;
+  long long label_entries() const;
+};
+
+#endif
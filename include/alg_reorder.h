@@ -0,0 +1,56 @@
+/******************************************************************************
+ *  File: alg_reorder.h
+ *
+ *  A header file defining vertex reorderings that improve memory locality.
+ *  A permutation maps every original vertex v to its new number perm[v];
+ *  relabel applies it, and to_original maps per-vertex results back.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_REORDER_H_
+#define _ADV_ALG_REORDER_H_
+
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Class: VertexOrdering
+ *  Computes and applies locality-improving vertex permutations.
+ ******************************************************************************/
+class VertexOrdering
+{
+private:
+  static std::vector<int> from_sequence(const std::vector<int> &sequence);
+
+public:
+  // Reverse Cuthill-McKee: a BFS from a pseudo-peripheral vertex of every
+  // component, visiting neighbors by increasing degree, reversed. Neighbors
+  // end up with nearby numbers (small bandwidth).
+  static std::vector<int> reverse_cuthill_mckee(const CSRGraph &g);
+
+  // Vertices by decreasing (or increasing) degree; hubs share cache lines
+  static std::vector<int> degree_sort(const CSRGraph &g, bool descending = true);
+
+  // Plain BFS order of every component, starting from its largest hub
+  static std::vector<int> bfs_order(const CSRGraph &g);
+
+  // The graph with vertex v renamed perm[v]; neighbor lists come out sorted
+  static CSRGraph relabel(const CSRGraph &g, const std::vector<int> &perm, int threads = 0);
+
+  static std::vector<int> inverse(const std::vector<int> &perm);
+
+  // Maps a per-vertex result computed on the relabeled graph back to the
+  // original vertex numbers
+  template <class T>
+  static std::vector<T> to_original(const std::vector<T> &values, const std::vector<int> &perm)
+  {
+    std::vector<T> original(perm.size());
+    for (std::size_t v = 0; v < perm.size(); v++)
+    {
+      original[v] = values[perm[v]];
+    }
+
+    return original;
+  }
+};
+
+#endif
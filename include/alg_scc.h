@@ -0,0 +1,81 @@
+/******************************************************************************
+ *  File: alg_scc.h
+ *
+ *  A header file defining strongly connected component (SCC) classes for
+ *  directed graphs. Both work on a CSRGraph snapshot and never recurse, so
+ *  their stack usage does not grow with the depth of the graph.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_SCC_H_
+#define _ADV_ALG_SCC_H_
+
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Class: StronglyConnectedComponents
+ *  A base class holding what every SCC algorithm produces: a component id per
+ *  vertex and the number of components. It keeps no reference to the graph,
+ *  so it may outlive it.
+ ******************************************************************************/
+class StronglyConnectedComponents
+{
+protected:
+  std::vector<int> _id; // Component id of every vertex
+  int _count = 0;       // Components count
+
+  explicit StronglyConnectedComponents(const CSRGraph &g);
+
+public:
+  int count() const;
+  int id(int v) const;
+  const std::vector<int> &ids() const;
+  bool strongly_connected(int v, int w) const;
+
+  // The DAG with one vertex per component and one edge for every pair of
+  // components joined by at least one edge of g, the graph these components
+  // were computed from.
+  CSRGraph condensation(const CSRGraph &g) const;
+
+  virtual ~StronglyConnectedComponents() noexcept;
+};
+
+/******************************************************************************
+ *  Class: TarjanSCC
+ *  A linear-time, iterative implementation of Tarjan's algorithm. Component
+ *  ids come out in reverse topological order: every edge of the condensation
+ *  goes from a larger id to a smaller one.
+ ******************************************************************************/
+class TarjanSCC : public StronglyConnectedComponents
+{
+public:
+  explicit TarjanSCC(const CSRGraph &g);
+};
+
+/******************************************************************************
+ *  Class: ParallelSCC
+ *  A multi-threaded SCC finder. It trims trivial components, peels the giant
+ *  component with one forward-backward search, breaks the rest apart with
+ *  color propagation and finishes small remainders with Tarjan. Component ids
+ *  carry no ordering.
+ ******************************************************************************/
+class ParallelSCC : public StronglyConnectedComponents
+{
+private:
+  int threads;
+
+  // Each phase reads the graph g and its transpose gt (in-edges), which
+  // only live while the constructor runs
+  long long trim(const CSRGraph &g, const CSRGraph &gt, std::vector<int> &active);
+  void forward_backward(const CSRGraph &g, const CSRGraph &gt, std::vector<int> &active);
+  void color_propagation(const CSRGraph &g, const CSRGraph &gt, std::vector<int> &active);
+  void compact(std::vector<int> &active) const;
+
+public:
+  // Below this many unassigned vertices the rest is handed to Tarjan
+  static constexpr int SERIAL_CUTOFF = 4096;
+
+  explicit ParallelSCC(const CSRGraph &g, int threads = 0);
+};
+
+#endif
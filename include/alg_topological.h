@@ -0,0 +1,42 @@
+/******************************************************************************
+ *  File: alg_topological.h
+ *
+ *  A header file defining a parallel, Kahn-style topological sort. Besides a
+ *  linear order it reports the waves (levels) of the DAG: all vertices of one
+ *  wave only depend on vertices of earlier waves, so they can run
+ *  concurrently.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_TOPOLOGICAL_H_
+#define _ADV_ALG_TOPOLOGICAL_H_
+
+#include <span>
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Class: TopologicalSort
+ *  Peels zero in-degree vertices wave by wave, decrementing atomic in-degree
+ *  counters in parallel. Vertices within a wave are listed in increasing
+ *  order, so the result does not depend on thread scheduling.
+ ******************************************************************************/
+class TopologicalSort
+{
+private:
+  int _V;
+  std::vector<int> _order;              // Vertices, wave after wave
+  std::vector<long long> _wave_offsets; // Wave k is _order[_wave_offsets[k] .. _wave_offsets[k + 1])
+  std::vector<int> _level;              // Wave of every vertex, -1 if it sits on or behind a cycle
+
+public:
+  explicit TopologicalSort(const CSRGraph &g, int threads = 0);
+
+  bool is_dag() const;
+  const std::vector<int> &order() const;
+
+  int levels_count() const;
+  std::span<const int> wave(int k) const;
+  int level(int v) const;
+};
+
+#endif
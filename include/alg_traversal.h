@@ -0,0 +1,219 @@
+/******************************************************************************
+ *  File: alg_traversal.h
+ *
+ *  A header file defining a compile-time visitor depth-first traversal. The
+ *  graph type and the visitor are template parameters: a visitor only
+ *  defines the hooks it needs, and the calls to missing hooks (and the work
+ *  feeding them) are never compiled. Nothing is recorded unless a hook
+ *  records it.
+ *
+ *  Hooks, all optional:
+ *    start(s)                     s is the root of a new DFS tree
+ *    discover(v)                  v is reached for the first time
+ *    tree_edge(v, w)              w is discovered from v
+ *    back_edge(v, w)              w is an ancestor of v (on the DFS stack)
+ *    forward_or_cross_edge(v, w)  w is already finished (directed only)
+ *    finish(v)                    all neighbors of v are done
+ *    done()                       returns true to stop the traversal early
+ *
+ *  Any graph with V(), is_directed() and neighbors(v) or adj(v) works
+ *  (Graph, Digraph, CSRGraph, CompressedGraph, DynamicGraph), provided its
+ *  neighbor iterators stay valid after the range returned is destroyed.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_TRAVERSAL_H_
+#define _ADV_ALG_TRAVERSAL_H_
+
+#include <concepts>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/******************************************************************************
+ *  Function: neighbors_of
+ *  The non-copying neighbor range of a graph: neighbors(v) if it has one,
+ *  adj(v) otherwise.
+ ******************************************************************************/
+template <class G>
+auto neighbors_of(const G &g, int v)
+{
+  if constexpr (requires { g.neighbors(v); })
+  {
+    return g.neighbors(v);
+  }
+  else
+  {
+    return g.adj(v);
+  }
+}
+
+/******************************************************************************
+ *  Class: DepthFirstTraversal
+ *  The state of an iterative DFS over one graph: vertex colors and the
+ *  explicit stack. It can run from several sources in a row, skipping what
+ *  earlier runs reached, like DepthFirstSearch with a list of sources.
+ ******************************************************************************/
+template <class G>
+class DepthFirstTraversal
+{
+private:
+  enum : unsigned char
+  {
+    WHITE,
+    GREY,
+    BLACK
+  };
+
+  using Iterator = decltype(neighbors_of(std::declval<const G &>(), 0).begin());
+
+  struct Frame
+  {
+    int v;
+    Iterator it, end;
+    int parent;               // -1 for roots
+    bool parent_seen = false; // The tree edge back to parent (undirected)
+  };
+
+  const G &g;
+  bool directed;
+  std::vector<unsigned char> color;
+  std::vector<Frame> stack;
+
+  // Colors v grey, pushes its frame and calls discover(v). Returns false if
+  // the visitor is done.
+  template <class Visitor>
+  bool enter(int v, int parent, Visitor &vis)
+  {
+    color[v] = GREY;
+    auto range = neighbors_of(g, v);
+    stack.push_back({v, range.begin(), range.end(), parent});
+    if constexpr (requires { vis.discover(v); })
+    {
+      vis.discover(v);
+    }
+
+    if constexpr (requires { { vis.done() } -> std::convertible_to<bool>; })
+    {
+      if (vis.done())
+      {
+        stack.clear();
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+public:
+  explicit DepthFirstTraversal(const G &g) : g(g), directed(g.is_directed()), color(g.V(), WHITE) {}
+
+  bool visited(int v) const { return color[v] != WHITE; }
+
+  // Searches from s unless s was already reached. Returns false if the
+  // visitor stopped the traversal.
+  template <class Visitor>
+  bool run(int s, Visitor &vis)
+  {
+    if (s < 0 || s >= static_cast<int>(color.size()))
+    {
+      throw std::runtime_error("vertex " + std::to_string(s) + " is not between 0 and " +
+                               std::to_string(static_cast<int>(color.size()) - 1));
+    }
+
+    if (color[s] != WHITE)
+    {
+      return true;
+    }
+
+    if constexpr (requires { vis.start(s); })
+    {
+      vis.start(s);
+    }
+
+    if (!enter(s, -1, vis))
+    {
+      return false;
+    }
+
+    while (!stack.empty())
+    {
+      Frame &f = stack.back();
+      if (f.it == f.end)
+      {
+        int v = f.v;
+        color[v] = BLACK;
+        stack.pop_back();
+        if constexpr (requires { vis.finish(v); })
+        {
+          vis.finish(v);
+        }
+        continue;
+      }
+
+      int v = f.v, w = *f.it;
+      ++f.it;
+      if (color[w] == WHITE)
+      {
+        if constexpr (requires { vis.tree_edge(v, w); })
+        {
+          vis.tree_edge(v, w);
+        }
+
+        if (!enter(w, v, vis)) // May reallocate the stack; f is not used after
+        {
+          return false;
+        }
+      }
+      else if (color[w] == GREY)
+      {
+        if (!directed && w == f.parent && !f.parent_seen)
+        {
+          f.parent_seen = true; // The tree edge seen from the other side
+          continue;
+        }
+
+        if constexpr (requires { vis.back_edge(v, w); })
+        {
+          vis.back_edge(v, w);
+        }
+      }
+      else if (directed)
+      {
+        if constexpr (requires { vis.forward_or_cross_edge(v, w); })
+        {
+          vis.forward_or_cross_edge(v, w);
+        }
+      }
+    }
+
+    return true;
+  }
+};
+
+/******************************************************************************
+ *  Function: traverse
+ *  Depth-first traversal of the whole graph (roots in vertex order), or of
+ *  what is reachable from s.
+ ******************************************************************************/
+template <class G, class Visitor>
+void traverse(const G &g, Visitor &vis)
+{
+  DepthFirstTraversal<G> dfs(g);
+  for (int s = 0; s < g.V(); s++)
+  {
+    if (!dfs.run(s, vis))
+    {
+      return;
+    }
+  }
+}
+
+template <class G, class Visitor>
+void traverse(const G &g, int s, Visitor &vis)
+{
+  DepthFirstTraversal<G> dfs(g);
+  dfs.run(s, vis);
+}
+
+#endif
@@ -0,0 +1,47 @@
+/******************************************************************************
+ *  File: alg_triangles.h
+ *
+ *  A header file defining triangle counting and local clustering
+ *  coefficients for undirected graphs.
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_TRIANGLES_H_
+#define _ADV_ALG_TRIANGLES_H_
+
+#include <span>
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Class: TriangleCounting
+ *  Counts every triangle once: edges are oriented from the lower to the
+ *  higher (degree, id) endpoint, so each vertex keeps at most sqrt(2E)
+ *  out-neighbors, and for every oriented edge v->w the sorted out-lists of v
+ *  and w are intersected. Intersections use SSE2 4x4 block compares where
+ *  available and galloping when one list is much longer. Vertices are
+ *  processed in parallel with dynamic scheduling. Parallel edges and
+ *  self-loops are ignored.
+ ******************************************************************************/
+class TriangleCounting
+{
+private:
+  std::vector<long long> _triangles; // Triangles through every vertex
+  std::vector<int> _degree;          // Distinct neighbors, self excluded
+  long long _count = 0;
+
+public:
+  explicit TriangleCounting(const CSRGraph &g, int threads = 0);
+  explicit TriangleCounting(const Graph &g, int threads = 0);
+
+  long long count() const;
+  long long triangles(int v) const;
+
+  // Share of the pairs of neighbors of v that are adjacent (0 if degree < 2)
+  double clustering(int v) const;
+  double average_clustering() const;
+
+  // Number of common elements of two sorted arrays without duplicates
+  static long long intersection_size(std::span<const int> a, std::span<const int> b);
+};
+
+#endif
@@ -12,7 +12,18 @@
 #ifndef _ADV_ALG_UF_H_
 #define _ADV_ALG_UF_H_
 
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
+#include "alg_hash.h"
+#include "alg_parallel.h"
+
 /******************************************************************************
  *  Class: UFable
  *  An abstract class capturing the essence of UF classes
@@ -141,78 +152,394 @@ public:
   }
 };
 
-/* TESTING
-#include <iostream>
-#include <iomanip>
-#include <sstream>
-#include <fstream>
-#include <string>
-#include "alg_uf.h"
-#include "alg_stopwatch.h"
+/******************************************************************************
+ *  Linking policies of UnionFind
+ *  Each one joins two distinct roots and returns the surviving root. The
+ *  value stored at a root is negative: -1 for the plain policies, -size
+ *  for LinkBySize and -(rank + 1) for LinkByRank.
+ ******************************************************************************/
+struct QuickFindLink {
+  // every element points straight at its root, so finds take one step
+  static int link(std::vector<int> &parent, int pRoot, int qRoot) {
+    for (int &x : parent) {
+      if (x == pRoot) x = qRoot;
+    }
+    parent[pRoot] = qRoot;
+    return qRoot;
+  }
+};
 
-using namespace std;
+struct QuickUnionLink {
+  static int link(std::vector<int> &parent, int pRoot, int qRoot) {
+    parent[pRoot] = qRoot;
+    return qRoot;
+  }
+};
 
-int main() {
-  // TODO
+struct LinkBySize {
+  static int link(std::vector<int> &parent, int pRoot, int qRoot) {
+    if (parent[pRoot] > parent[qRoot]) std::swap(pRoot, qRoot); // pRoot is the larger
+    parent[pRoot] += parent[qRoot];
+    parent[qRoot] = pRoot;
+    return pRoot;
+  }
+};
 
-  struct Algorithm {
-    string name;
-    UFable *impl;
-    long runningTime;
-  };
+struct LinkByRank {
+  static int link(std::vector<int> &parent, int pRoot, int qRoot) {
+    if (parent[pRoot] > parent[qRoot]) std::swap(pRoot, qRoot); // pRoot has the higher rank
+    if (parent[pRoot] == parent[qRoot]) parent[pRoot]--;
+    parent[qRoot] = pRoot;
+    return pRoot;
+  }
+};
 
-  string inputFiles [] = {
-    "../resources/tinyUF.txt", "../resources/mediumUF.txt"
-    };
+/******************************************************************************
+ *  Compression policies of UnionFind
+ *  Each one finds the root of p (the first element with a negative value)
+ *  and shortens the path it walked, or not.
+ ******************************************************************************/
+struct NoCompression {
+  static int find(std::vector<int> &parent, int p) {
+    while (parent[p] >= 0) p = parent[p];
+    return p;
+  }
+};
 
-  ostringstream report;
-  report << setw(27) << "Input"
-         << setw(7) << "N"
-         << setw(10) << "Algorithm"
-         << setw(11) << "Components"
-         << setw(16) << "Time(millisecs)" << endl;
-  report << string(72, '=') << endl;
-  for (string inputFile : inputFiles) {
-    ifstream in(inputFile);
-    int n;
-
-    in >> n;
-    Algorithm algorithms [] = {
-        { "UF", new UF(n) },
-        { "QU", new QuickUF(n) },
-        { "WQ", new WeightedQuickUF(n) }, 
-        { "PC", new PCWQuickUF(n) }
-    };
-    in.close();
+struct PathHalving {
+  static int find(std::vector<int> &parent, int p) {
+    while (parent[p] >= 0) {
+      int q = parent[p];
+      if (parent[q] < 0) return q;
+      parent[p] = parent[q];  // skip a level and jump there
+      p = parent[p];
+    }
+    return p;
+  }
+};
 
-    for (Algorithm a : algorithms) {
-      int p, q;
-      ifstream in(inputFile);
-      in >> n;
-      StopWatch sw;
+struct PathSplitting {
+  static int find(std::vector<int> &parent, int p) {
+    while (parent[p] >= 0) {
+      int q = parent[p];
+      if (parent[q] < 0) return q;
+      parent[p] = parent[q];  // skip a level, but step to the old parent
+      p = q;
+    }
+    return p;
+  }
+};
+
+struct FullCompression {
+  static int find(std::vector<int> &parent, int p) {
+    int root = p;
+    while (parent[root] >= 0) root = parent[root];
+    while (parent[p] >= 0 && parent[p] != root) {
+      int next = parent[p];
+      parent[p] = root;
+      p = next;
+    }
+    return root;
+  }
+};
 
-      while (in >> p >> q) {
-        cout << p << '-' << q << endl;
-        a.impl->_union(p, q);
+/******************************************************************************
+ *  Class: UnionFind
+ *  A union-find with its linking and compression chosen at compile time,
+ *  so finds inline into the calling loop. Parents and root sizes (or ranks)
+ *  share one int array, half the memory of the id/sz pair above. It has the
+ *  interface of UFable without deriving from it.
+ ******************************************************************************/
+template <class Link = LinkBySize, class Compress = PathHalving>
+class UnionFind {
+protected:
+  std::vector<int> parent;
+  int count;
+
+public:
+  UnionFind(int N): parent(N, -1), count(N) {}
+
+  int components_count() const { return count; }
+
+  bool connected(int p, int q) { return _find(p) == _find(q); }
+
+  int _find(int p) { return Compress::find(parent, p); }
+
+  bool _union(int p, int q) {
+    int pRoot = _find(p);
+    int qRoot = _find(q);
+    if (pRoot == qRoot) return false;
+    Link::link(parent, pRoot, qRoot);
+    count--;
+    return true;
+  }
+
+  // number of elements in the component of p
+  int size(int p) requires std::same_as<Link, LinkBySize> { return -parent[_find(p)]; }
+
+  // Unions every pair in order, prefetching the entries of the pair a few
+  // steps ahead so their cache misses overlap with the current union.
+  // Returns the number of pairs that merged two components.
+  int union_batch(std::span<const std::pair<int, int>> pairs) {
+    constexpr std::size_t AHEAD = 8;
+    int merged = 0;
+    for (std::size_t i = 0; i < pairs.size(); i++) {
+#if defined(__GNUC__)
+      if (i + AHEAD < pairs.size()) {
+        __builtin_prefetch(&parent[pairs[i + AHEAD].first]);
+        __builtin_prefetch(&parent[pairs[i + AHEAD].second]);
       }
+#endif
+      merged += _union(pairs[i].first, pairs[i].second);
+    }
+    return merged;
+  }
+
+  // Answers connected(p, q) for every pair, in parallel. Finds only read
+  // the parent array (no compression), so no union may run meanwhile.
+  std::vector<char> connected_batch(std::span<const std::pair<int, int>> queries, int threads = 0) const {
+    auto root = [this](int p) {
+      while (parent[p] >= 0) p = parent[p];
+      return p;
+    };
+
+    std::vector<char> answers(queries.size());
+    parallel_for(0, static_cast<long long>(queries.size()),
+                 [&](long long i) { answers[i] = root(queries[i].first) == root(queries[i].second); }, threads, 4096);
+    return answers;
+  }
+};
+
+// Inlined, single-array counterparts of the four classes above
+using PackedUF = UnionFind<QuickFindLink, NoCompression>;
+using PackedQuickUF = UnionFind<QuickUnionLink, NoCompression>;
+using PackedWeightedQuickUF = UnionFind<LinkBySize, NoCompression>;
+using PackedPCWQuickUF = UnionFind<LinkBySize, PathHalving>;
+
+/******************************************************************************
+ *  Class: RollbackUF
+ *  Union by rank without path compression, so every union changes two
+ *  entries and can be undone exactly. snapshot() marks the current state
+ *  and rollback() undoes the unions made since, newest first, in O(1)
+ *  each. Finds take O(log N) steps. The UnionFind it is built on is
+ *  private, so no union can bypass the undo log; only its read-only
+ *  members are exposed.
+ ******************************************************************************/
+class RollbackUF : private UnionFind<LinkByRank, NoCompression> {
+private:
+  struct Change {
+    int child, childValue;  // root linked under another
+    int root, rootValue;    // the surviving root, rank before the union
+  };
+  std::vector<Change> history;
+
+public:
+  RollbackUF(int N): UnionFind(N) {}
+
+  using UnionFind::components_count;
+  using UnionFind::connected;
+  using UnionFind::_find;
+  using UnionFind::connected_batch;
+
+  bool _union(int p, int q) {
+    int pRoot = _find(p);
+    int qRoot = _find(q);
+    if (pRoot == qRoot) return false;
+
+    Change c = {pRoot, parent[pRoot], qRoot, parent[qRoot]};
+    if (LinkByRank::link(parent, pRoot, qRoot) == pRoot) {
+      c = {qRoot, c.rootValue, pRoot, c.childValue};
+    }
+    history.push_back(c);
+    count--;
+    return true;
+  }
+
+  std::size_t snapshot() const { return history.size(); }
+
+  void rollback(std::size_t snapshot) {
+    while (history.size() > snapshot) {
+      const Change &c = history.back();
+      parent[c.child] = c.childValue;
+      parent[c.root] = c.rootValue;
+      history.pop_back();
+      count++;
+    }
+  }
+};
+
+/******************************************************************************
+ *  Class: SparseUF
+ *  A union-find over arbitrary 64-bit keys (except ~0), added on the fly.
+ *  A FlatHashMap gives each key a dense slot; slots live in fixed-size
+ *  chunks that are never moved or copied when more are added, so memory
+ *  follows the number of keys, not their range. Slots hold parents and root
+ *  sizes in one int, like UnionFind<LinkBySize, PathHalving>.
+ ******************************************************************************/
+class SparseUF {
+private:
+  static constexpr int CHUNK_BITS = 12;
+  static constexpr int CHUNK = 1 << CHUNK_BITS;
+
+  FlatHashMap<std::uint64_t, int> slots;
+  std::vector<std::unique_ptr<int[]>> parents;        // By slot
+  std::vector<std::unique_ptr<std::uint64_t[]>> keys; // By slot
+  int _size = 0;
+  int count = 0;
+
+  int &parent(int s) { return parents[s >> CHUNK_BITS][s & (CHUNK - 1)]; }
+  std::uint64_t key(int s) const { return keys[s >> CHUNK_BITS][s & (CHUNK - 1)]; }
+
+  int root(int s) {
+    while (parent(s) >= 0) {
+      int t = parent(s);
+      if (parent(t) < 0) return t;
+      parent(s) = parent(t);  // path compression by halving
+      s = parent(s);
+    }
+    return s;
+  }
 
-      a.runningTime = sw.elapsed_time();
-      in.close();
-      report << setw(27) << inputFile
-             << setw(7) << n
-             << setw(10) << a.name
-             << setw(11) << a.impl->components_count()
-             << setw(16) << a.runningTime << endl;
+public:
+  SparseUF() {}
+
+  // makes room for n keys without rehashing
+  void reserve(int n) { slots.reserve(n); }
 
-      delete a.impl;
+  // adds key as a singleton unless present; returns its slot
+  int add(std::uint64_t k) {
+    if (k == ~std::uint64_t(0)) throw std::runtime_error("Key ~0 cannot be stored");
+    if (const int *s = slots.find(k)) return *s;
 
-      in.close();
+    if ((_size & (CHUNK - 1)) == 0) {
+      parents.emplace_back(new int[CHUNK]);
+      keys.emplace_back(new std::uint64_t[CHUNK]);
     }
+    int s = _size++;
+    slots.insert(k, s);
+    parent(s) = -1;
+    keys[s >> CHUNK_BITS][s & (CHUNK - 1)] = k;
+    count++;
+    return s;
   }
 
-  cout << report.str() << endl;
+  bool contains(std::uint64_t k) const { return slots.find(k) != nullptr; }
+
+  int size() const { return _size; }
+
+  int components_count() const { return count; }
+
+  // key of the root of k, adding k if needed
+  std::uint64_t _find(std::uint64_t k) { return key(root(add(k))); }
+
+  // absent keys count as singletons and are not added
+  bool connected(std::uint64_t p, std::uint64_t q) {
+    if (p == q) return true;
+    const int *s = slots.find(p);
+    const int *t = slots.find(q);
+    return s && t && root(*s) == root(*t);
+  }
+
+  // adds p and q if needed
+  bool _union(std::uint64_t p, std::uint64_t q) {
+    int pRoot = root(add(p));
+    int qRoot = root(add(q));
+    if (pRoot == qRoot) return false;
+
+    if (parent(pRoot) > parent(qRoot)) std::swap(pRoot, qRoot);
+    parent(pRoot) += parent(qRoot);
+    parent(qRoot) = pRoot;
+    count--;
+    return true;
+  }
+
+  // number of keys in the component of k (1 if absent)
+  int component_size(std::uint64_t k) {
+    const int *s = slots.find(k);
+    return s ? -parent(root(*s)) : 1;
+  }
+
+  // slot storage in bytes, not counting the hash table
+  std::size_t bytes() const { return parents.size() * CHUNK * (sizeof(int) + sizeof(std::uint64_t)); }
+};
+
+/******************************************************************************
+ *  Class: ConcurrentUF
+ *  A lock-free union-find (Jayanti-Tarjan) that many threads can call
+ *  _union, _find and connected on at once. Roots are linked with a single
+ *  CAS, always under the root of higher random priority (a fixed hash of the
+ *  index), which keeps trees shallow without storing ranks. Finds split
+ *  paths with CASes that may fail harmlessly when another thread got there
+ *  first. components_count() is exact once the unions have returned.
+ ******************************************************************************/
+class ConcurrentUF : public UFable {
+protected:
+  std::vector<int> id;
+  std::atomic<int> count;
+
+  static std::uint64_t priority(int p) {
+    return hash_mix(static_cast<std::uint64_t>(p));
+  }
+
+  int parent(int p) {
+    return std::atomic_ref<int>(id[p]).load(std::memory_order_acquire);
+  }
+
+public:
+  ConcurrentUF(int N): id(N), count(N) {
+    for (int i = 0; i < N; i++) {
+      id[i] = i;
+    }
+  }
+
+  int components_count() const override { return count.load(std::memory_order_relaxed); }
+
+  int _find(int p) override {
+    while (true) {
+      int q = parent(p);
+      int r = parent(q);
+      if (q == r) return q;
+      // path splitting: point p at its grandparent, then move on to q
+      std::atomic_ref<int>(id[p]).compare_exchange_weak(q, r, std::memory_order_acq_rel);
+      p = q;
+    }
+  }
+
+  bool _union(int p, int q) override {
+    while (true) {
+      int pRoot = _find(p);
+      int qRoot = _find(q);
+      if (pRoot == qRoot) return false;
+
+      if (priority(pRoot) > priority(qRoot) || (priority(pRoot) == priority(qRoot) && pRoot > qRoot)) {
+        std::swap(pRoot, qRoot);
+      }
+
+      // fails if pRoot stopped being a root meanwhile; then retry
+      int expected = pRoot;
+      if (std::atomic_ref<int>(id[pRoot]).compare_exchange_strong(expected, qRoot, std::memory_order_acq_rel)) {
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+
+  bool connected(int p, int q) override {
+    while (true) {
+      int pRoot = _find(p);
+      int qRoot = _find(q);
+      if (pRoot == qRoot) return true;
+      // still a root after both finds: p and q were apart at that moment
+      if (parent(pRoot) == pRoot) return false;
+    }
+  }
+
+  // Unions every pair, spread over the given number of threads
+  void union_all(const std::vector<std::pair<int, int>> &pairs, int threads = 0) {
+    parallel_for(0, static_cast<long long>(pairs.size()),
+                 [&](long long i) { _union(pairs[i].first, pairs[i].second); }, threads, 4096);
+  }
+};
 
-  return 0;
-}*/
 #endif
 
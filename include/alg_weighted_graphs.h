@@ -0,0 +1,174 @@
+/******************************************************************************
+ *  File: alg_weighted_graphs.h
+ *
+ *  A header file defining edge-weighted graphs and single-source shortest
+ *  path (SSSP) classes. Weights are non-negative and either integers (e.g.
+ *  meters or milliseconds on a road network), which is what lets Dijkstra
+ *  use a radix heap, or doubles, as in the algs4 data files. Every class is
+ *  a template over the weight type, instantiated for long long (the
+ *  unprefixed names) and double (the Real names).
+ ******************************************************************************/
+
+#ifndef _ADV_ALG_WEIGHTED_GRAPHS_H_
+#define _ADV_ALG_WEIGHTED_GRAPHS_H_
+
+#include <iostream>
+#include <limits>
+#include <span>
+#include <stack>
+#include <string>
+#include <vector>
+#include "alg_csr.h"
+
+/******************************************************************************
+ *  Struct: BasicWeightedEdge
+ *  An edge v-w (or v->w) with a weight.
+ ******************************************************************************/
+template <class Weight>
+struct BasicWeightedEdge
+{
+  int v = 0, w = 0;
+  Weight weight = 0;
+
+  int other(int x) const { return x == v ? w : v; }
+  bool operator==(const BasicWeightedEdge &e) const = default;
+};
+
+/******************************************************************************
+ *  Class: BasicEdgeWeightedGraph
+ *  A CSRGraph with a weight next to every arc: the arc targets()[i] weighs
+ *  weights()[i]. Like CSRGraph, undirected graphs store both directions of
+ *  every edge, each with the same weight.
+ ******************************************************************************/
+template <class Weight>
+class BasicEdgeWeightedGraph
+{
+private:
+  CSRGraph _topology;
+  std::vector<Weight> _weights; // Parallel to _topology.targets()
+  Weight _max_weight = 0;
+
+public:
+  using Edge = BasicWeightedEdge<Weight>;
+
+  // Constructors
+  BasicEdgeWeightedGraph();
+  BasicEdgeWeightedGraph(int V, const std::vector<Edge> &edges, bool directed);
+
+  // Vertices and edges
+  int V() const;
+  long long E() const;
+  long long arcs() const;
+  bool is_directed() const;
+  int degree(int v) const;
+  Weight max_weight() const;
+
+  // Neighbors of v and the weights of the arcs leading to them
+  std::span<const int> adj(int v) const;
+  std::span<const Weight> weights(int v) const;
+
+  // Every edge once (v < w for undirected graphs, unless a self-loop)
+  std::vector<Edge> edges() const;
+
+  // The unweighted structure, for the CSRGraph algorithms
+  const CSRGraph &topology() const;
+
+  // Input/output in the algs4 "V E, then v w weight per line" format
+  std::string str() const;
+  template <class W>
+  friend std::ostream &operator<<(std::ostream &out, const BasicEdgeWeightedGraph<W> &g);
+  static BasicEdgeWeightedGraph read(std::istream &in, bool directed);
+};
+
+/******************************************************************************
+ *  Class: BasicShortestPaths
+ *  A base class holding what every SSSP algorithm produces: the distance of
+ *  every vertex from the source and a shortest path tree.
+ ******************************************************************************/
+template <class Weight>
+class BasicShortestPaths
+{
+protected:
+  int s;
+  std::vector<Weight> _dist;
+  std::vector<int> _parent; // Previous vertex on a shortest path, or -1
+
+  BasicShortestPaths(int V, int s);
+
+public:
+  static constexpr Weight INFINITY_DIST = std::numeric_limits<Weight>::max();
+
+  int source() const;
+  Weight dist_to(int v) const;
+  bool has_path_to(int v) const;
+  std::stack<int> path_to(int v) const; // Source on top
+  const std::vector<Weight> &distances() const;
+
+  virtual ~BasicShortestPaths() noexcept;
+};
+
+/******************************************************************************
+ *  Class: BasicDijkstraSP
+ *  Dijkstra's algorithm with either an indexed 4-ary heap (decrease-key in
+ *  place, children of a node share a cache line) or, for integer weights, a
+ *  monotone radix heap, which only ever moves an entry to a lower bucket, at
+ *  most 64 times.
+ ******************************************************************************/
+enum class DijkstraHeap
+{
+  FourAry,
+  Radix
+};
+
+template <class Weight>
+class BasicDijkstraSP : public BasicShortestPaths<Weight>
+{
+public:
+  // Throws a runtime_error if a radix heap is asked for with double weights
+  BasicDijkstraSP(const BasicEdgeWeightedGraph<Weight> &g, int s, DijkstraHeap heap = DijkstraHeap::FourAry);
+};
+
+/******************************************************************************
+ *  Class: BasicDeltaSteppingSP
+ *  Parallel delta-stepping. Vertices are kept in buckets of width delta; the
+ *  light arcs (weight <= delta) of the current bucket are relaxed in parallel
+ *  until it empties, then its heavy arcs once. A width of 0 picks
+ *  max_weight / average degree. Pending distances span at most
+ *  max_weight / delta + 1 buckets, so that many (but never more than
+ *  MAX_BUCKETS) are kept and reused cyclically; a vertex filed a lap ahead
+ *  waits in its slot until its bucket comes round, and empty laps are
+ *  skipped.
+ ******************************************************************************/
+template <class Weight>
+class BasicDeltaSteppingSP : public BasicShortestPaths<Weight>
+{
+private:
+  Weight delta;
+  int threads;
+
+  long long bucket_of(Weight d) const;
+  void build_tree(const BasicEdgeWeightedGraph<Weight> &g);
+
+public:
+  static constexpr long long MAX_BUCKETS = 1 << 16;
+
+  BasicDeltaSteppingSP(const BasicEdgeWeightedGraph<Weight> &g, int s, Weight width = 0, int threads = 0);
+
+  Weight bucket_width() const;
+};
+
+// Integer weights
+using WeightedEdge = BasicWeightedEdge<long long>;
+using EdgeWeightedGraph = BasicEdgeWeightedGraph<long long>;
+using ShortestPaths = BasicShortestPaths<long long>;
+using DijkstraSP = BasicDijkstraSP<long long>;
+using DeltaSteppingSP = BasicDeltaSteppingSP<long long>;
+
+// Real weights
+using RealWeightedEdge = BasicWeightedEdge<double>;
+using RealEdgeWeightedGraph = BasicEdgeWeightedGraph<double>;
+using RealShortestPaths = BasicShortestPaths<double>;
+using RealDijkstraSP = BasicDijkstraSP<double>;
+using RealDeltaSteppingSP = BasicDeltaSteppingSP<double>;
+
+#endif
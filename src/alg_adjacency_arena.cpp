@@ -0,0 +1,203 @@
+/******************************************************************************
+ *  File: alg_adjacency_arena.cpp
+ *
+ *  An implementation file of the arena-backed adjacency store.
+ ******************************************************************************/
+
+#include <algorithm>
+#include "alg_adjacency_arena.h"
+
+/******************************************************************************
+ *  Class: AdjacencyArena
+ *  Per-vertex neighbor lists in chained blocks.
+ ******************************************************************************/
+AdjacencyArena::AdjacencyArena(int V) : chains(V) {}
+
+void AdjacencyArena::reset(int V)
+{
+  pages.clear();
+  blocks.clear();
+  chains.assign(V, Chain());
+}
+
+// Carves a block out of the last page (or a new one) and links it at the
+// tail of v's chain
+int AdjacencyArena::allocate(int v, int capacity)
+{
+  if (pages.empty() || pages.back().size() + capacity > pages.back().capacity())
+  {
+    // Pages double up to PAGE entries, so small graphs stay small
+    std::size_t used = pages.empty() ? 0 : pages.size() * pages.back().capacity();
+    pages.emplace_back();
+    pages.back().reserve(std::max<std::size_t>(capacity, std::clamp<std::size_t>(used, 1024, PAGE)));
+  }
+
+  std::vector<int> &page = pages.back();
+  int id = static_cast<int>(blocks.size());
+  blocks.push_back({static_cast<int>(pages.size()) - 1, static_cast<int>(page.size()), capacity, 0});
+  page.resize(page.size() + capacity);
+
+  Chain &chain = chains[v];
+  if (chain.tail == -1)
+  {
+    chain.head = id;
+  }
+  else
+  {
+    blocks[chain.tail].next = id;
+  }
+  chain.tail = id;
+
+  return id;
+}
+
+int AdjacencyArena::vertices() const { return static_cast<int>(chains.size()); }
+
+int AdjacencyArena::size(int v) const { return chains[v].size; }
+
+AdjacencyArena::Range AdjacencyArena::operator[](int v) const { return Range(this, v); }
+
+// Adding/removing
+void AdjacencyArena::push_back(int v, int w)
+{
+  Chain &chain = chains[v];
+  int b = chain.tail;
+  if (b == -1 || blocks[b].size == blocks[b].capacity)
+  {
+    b = allocate(v, std::clamp(chain.size, MIN_BLOCK, MAX_BLOCK));
+  }
+
+  data(blocks[b])[blocks[b].size++] = w;
+  chain.size++;
+}
+
+void AdjacencyArena::append(int v, std::span<const int> list)
+{
+  std::size_t done = 0;
+  int b = chains[v].tail;
+  while (done < list.size())
+  {
+    if (b == -1 || blocks[b].size == blocks[b].capacity)
+    {
+      b = allocate(v, static_cast<int>(std::clamp<std::size_t>(list.size() - done, MIN_BLOCK, PAGE)));
+    }
+
+    Block &block = blocks[b];
+    int n = static_cast<int>(std::min<std::size_t>(list.size() - done, block.capacity - block.size));
+    std::copy(list.begin() + done, list.begin() + done + n, data(block) + block.size);
+    block.size += n;
+    done += n;
+  }
+
+  chains[v].size += static_cast<int>(list.size());
+}
+
+bool AdjacencyArena::erase(int v, int w)
+{
+  for (int b = chains[v].head; b != -1; b = blocks[b].next)
+  {
+    Block &block = blocks[b];
+    int *entries = data(block);
+    int *it = std::find(entries, entries + block.size, w);
+    if (it != entries + block.size)
+    {
+      std::copy(it + 1, entries + block.size, it);
+      block.size--;
+      chains[v].size--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool AdjacencyArena::contains(int v, int w) const
+{
+  for (int b = chains[v].head; b != -1; b = blocks[b].next)
+  {
+    const int *entries = data(blocks[b]);
+    if (std::find(entries, entries + blocks[b].size, w) != entries + blocks[b].size)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Memory use
+std::size_t AdjacencyArena::pages_count() const { return pages.size(); }
+
+std::size_t AdjacencyArena::blocks_count() const { return blocks.size(); }
+
+std::size_t AdjacencyArena::bytes() const
+{
+  std::size_t entries = 0;
+  for (const std::vector<int> &page : pages)
+  {
+    entries += page.capacity();
+  }
+
+  return entries * sizeof(int) + blocks.capacity() * sizeof(Block) + chains.capacity() * sizeof(Chain);
+}
+
+/******************************************************************************
+ *  Class: AdjacencyArena::Iterator
+ *  A forward iterator over the neighbors of one vertex.
+ ******************************************************************************/
+AdjacencyArena::Iterator::Iterator(const AdjacencyArena *arena, int block) : arena(arena), block(block)
+{
+  skip_empty();
+}
+
+// Moves past blocks emptied by erase
+void AdjacencyArena::Iterator::skip_empty()
+{
+  while (block != -1 && i == arena->blocks[block].size)
+  {
+    block = arena->blocks[block].next;
+    i = 0;
+  }
+}
+
+int AdjacencyArena::Iterator::operator*() const
+{
+  return arena->data(arena->blocks[block])[i];
+}
+
+AdjacencyArena::Iterator &AdjacencyArena::Iterator::operator++()
+{
+  i++;
+  skip_empty();
+  return *this;
+}
+
+AdjacencyArena::Iterator AdjacencyArena::Iterator::operator++(int)
+{
+  Iterator old = *this;
+  ++*this;
+  return old;
+}
+
+bool AdjacencyArena::Iterator::operator==(const Iterator &other) const
+{
+  return block == other.block && i == other.i;
+}
+
+/******************************************************************************
+ *  Class: AdjacencyArena::Range
+ *  The neighbors of one vertex.
+ ******************************************************************************/
+AdjacencyArena::Range::Range(const AdjacencyArena *arena, int v) : arena(arena), v(v) {}
+
+AdjacencyArena::Iterator AdjacencyArena::Range::begin() const
+{
+  return Iterator(arena, arena->chains[v].head);
+}
+
+AdjacencyArena::Iterator AdjacencyArena::Range::end() const
+{
+  return Iterator(arena, -1);
+}
+
+int AdjacencyArena::Range::size() const { return arena->size(v); }
@@ -0,0 +1,153 @@
+/******************************************************************************
+ *  File: alg_bidirectional_bfs.cpp
+ *
+ *  An implementation file of the bidirectional BFS point-to-point queries.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "alg_bidirectional_bfs.h"
+
+/******************************************************************************
+ *  Struct: SearchBuffers
+ *  The scratch state of one thread's queries. stamp[v] is 2 * epoch + side
+ *  when side (0 forward, 1 backward) reached v in the current query; any
+ *  other value means unvisited, so a new query only bumps the epoch.
+ ******************************************************************************/
+struct SearchBuffers
+{
+  std::uint32_t epoch = 0;
+  std::vector<std::uint32_t> stamp;
+  std::vector<int> parent, depth;
+  std::vector<int> frontier[2], next;
+
+  // Starts a query over V vertices
+  void begin(int V)
+  {
+    if (static_cast<int>(stamp.size()) < V)
+    {
+      stamp.resize(V, 0);
+      parent.resize(V);
+      depth.resize(V);
+    }
+
+    if (++epoch >= (UINT32_MAX >> 1))
+    {
+      std::fill(stamp.begin(), stamp.end(), 0);
+      epoch = 1;
+    }
+  }
+
+  void visit(int v, int side, int from, int d)
+  {
+    stamp[v] = 2 * epoch + side;
+    parent[v] = from;
+    depth[v] = d;
+  }
+
+  int side(int v) const
+  {
+    return stamp[v] >> 1 == epoch ? static_cast<int>(stamp[v] & 1) : -1;
+  }
+};
+
+static thread_local SearchBuffers buffers;
+
+/******************************************************************************
+ *  Class: BidirectionalBFS
+ *  Point-to-point shortest paths by bidirectional BFS.
+ ******************************************************************************/
+BidirectionalBFS::BidirectionalBFS(const Graph &g) : forward(g) {}
+
+BidirectionalBFS::BidirectionalBFS(const Digraph &g) : forward(g), backward(g.reverse()) {}
+
+BidirectionalBFS::BidirectionalBFS(const CSRGraph &g)
+    : forward(g), backward(g.is_directed() ? g.transpose() : CSRGraph()) {}
+
+const CSRGraph &BidirectionalBFS::in_edges() const
+{
+  return forward.is_directed() ? backward : forward;
+}
+
+std::vector<int> BidirectionalBFS::shortest_path(int s, int t) const
+{
+  const int V = forward.V();
+  for (int v : {s, t})
+  {
+    if (v < 0 || v >= V)
+    {
+      throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(V - 1));
+    }
+  }
+
+  if (s == t)
+  {
+    return {s};
+  }
+
+  SearchBuffers &b = buffers;
+  b.begin(V);
+  b.visit(s, 0, -1, 0);
+  b.visit(t, 1, -1, 0);
+  b.frontier[0].assign(1, s);
+  b.frontier[1].assign(1, t);
+  const CSRGraph *graphs[2] = {&forward, &in_edges()};
+
+  // The best meeting edge x -> y (forward side x, backward side y) so far
+  int best = -1, meet_x = -1, meet_y = -1;
+  while (best == -1 && !b.frontier[0].empty() && !b.frontier[1].empty())
+  {
+    int side = b.frontier[0].size() <= b.frontier[1].size() ? 0 : 1;
+    b.next.clear();
+    for (int x : b.frontier[side])
+    {
+      for (int y : graphs[side]->adj(x))
+      {
+        int owner = b.side(y);
+        if (owner == -1)
+        {
+          b.visit(y, side, x, b.depth[x] + 1);
+          b.next.push_back(y);
+        }
+        else if (owner != side)
+        {
+          // Finish the level: a later meeting of it may be shorter
+          int length = b.depth[x] + 1 + b.depth[y];
+          if (best == -1 || length < best)
+          {
+            best = length;
+            meet_x = side == 0 ? x : y;
+            meet_y = side == 0 ? y : x;
+          }
+        }
+      }
+    }
+
+    b.frontier[side].swap(b.next);
+  }
+
+  if (best == -1)
+  {
+    return {};
+  }
+
+  std::vector<int> path;
+  for (int v = meet_x; v != -1; v = b.parent[v])
+  {
+    path.push_back(v);
+  }
+  std::reverse(path.begin(), path.end());
+  for (int v = meet_y; v != -1; v = b.parent[v])
+  {
+    path.push_back(v);
+  }
+
+  return path;
+}
+
+int BidirectionalBFS::distance(int s, int t) const
+{
+  return static_cast<int>(shortest_path(s, t).size()) - 1;
+}
@@ -0,0 +1,203 @@
+/******************************************************************************
+ *  File: alg_compressed_graph.cpp
+ *
+ *  An implementation file of the compressed (gap + varint) graph.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include "alg_compressed_graph.h"
+#include "alg_parallel.h"
+
+/******************************************************************************
+ *  Varint helpers
+ ******************************************************************************/
+static int varint_size(unsigned x)
+{
+  int size = 1;
+  while (x >= 0x80)
+  {
+    x >>= 7;
+    size++;
+  }
+
+  return size;
+}
+
+static unsigned char *write_varint(unsigned char *p, unsigned x)
+{
+  while (x >= 0x80)
+  {
+    *p++ = static_cast<unsigned char>(x | 0x80);
+    x >>= 7;
+  }
+
+  *p++ = static_cast<unsigned char>(x);
+  return p;
+}
+
+static unsigned zigzag(int x)
+{
+  return (static_cast<unsigned>(x) << 1) ^ static_cast<unsigned>(x >> 31);
+}
+
+// Encodes the sorted list of v at p (or only measures it if p is null) and
+// returns the number of bytes used
+static long long encode_list(int v, const std::vector<int> &list, unsigned char *p)
+{
+  long long size = varint_size(list.size());
+  if (p != nullptr)
+  {
+    p = write_varint(p, list.size());
+  }
+
+  for (std::size_t i = 0; i < list.size(); i++)
+  {
+    unsigned code = i == 0 ? zigzag(list[0] - v) : static_cast<unsigned>(list[i] - list[i - 1]);
+    size += varint_size(code);
+    if (p != nullptr)
+    {
+      p = write_varint(p, code);
+    }
+  }
+
+  return size;
+}
+
+/******************************************************************************
+ *  Class: CompressedGraph
+ *  A read-only graph with gap + varint encoded neighbor lists.
+ ******************************************************************************/
+// Constructors
+CompressedGraph::CompressedGraph(const CSRGraph &g, int threads)
+    : _V(g.V()), _E(g.E()), _directed(g.is_directed()), _anchors((g.V() >> BLOCK_BITS) + 1), _offsets(g.V())
+{
+  threads = resolve_threads(threads);
+  std::vector<std::vector<int>> lists(threads);
+  auto sorted = [&](int tid, int v) -> const std::vector<int> &
+  {
+    std::vector<int> &list = lists[tid];
+    list.assign(g.adj(v).begin(), g.adj(v).end());
+    std::sort(list.begin(), list.end());
+    return list;
+  };
+
+  // Measure every list, then encode each one at its final position
+  std::vector<long long> position(_V + 1, 0);
+  parallel_chunks(
+      0, _V, [&](int tid, long long lo, long long hi)
+      {
+        for (long long v = lo; v < hi; v++)
+        {
+          position[v + 1] = encode_list(v, sorted(tid, v), nullptr);
+        } },
+      threads);
+
+  for (int v = 0; v < _V; v++)
+  {
+    position[v + 1] += position[v];
+  }
+
+  for (int v = 0; v < _V; v++)
+  {
+    long long &anchor = _anchors[v >> BLOCK_BITS];
+    if ((v & ((1 << BLOCK_BITS) - 1)) == 0)
+    {
+      anchor = position[v];
+    }
+
+    if (position[v] - anchor > UINT32_MAX)
+    {
+      throw std::runtime_error("The lists of the block of vertex " + std::to_string(v) + " exceed 4 GiB");
+    }
+    _offsets[v] = static_cast<std::uint32_t>(position[v] - anchor);
+  }
+
+  _bytes.resize(position[_V]);
+  parallel_chunks(
+      0, _V, [&](int tid, long long lo, long long hi)
+      {
+        for (long long v = lo; v < hi; v++)
+        {
+          encode_list(v, sorted(tid, v), _bytes.data() + position[v]);
+        } },
+      threads);
+}
+
+CompressedGraph::CompressedGraph(const BaseGraph &g, int threads) : CompressedGraph(CSRGraph(g), threads) {}
+
+// Vertices and edges
+int CompressedGraph::V() const { return _V; }
+
+long long CompressedGraph::E() const { return _E; }
+
+bool CompressedGraph::is_directed() const { return _directed; }
+
+bool CompressedGraph::edge(int v, int w) const
+{
+  if (v < 0 || v >= _V || w < 0 || w >= _V)
+  {
+    throw std::runtime_error("vertex " + std::to_string(v < 0 || v >= _V ? v : w) + " is not between 0 and " + std::to_string(_V - 1));
+  }
+
+  // Lists are sorted, so the scan stops at the first neighbor >= w
+  for (int x : adj(v))
+  {
+    if (x >= w)
+    {
+      return x == w;
+    }
+  }
+
+  return false;
+}
+
+// Where the list of v starts
+const unsigned char *CompressedGraph::list(int v) const
+{
+  return _bytes.data() + _anchors[v >> BLOCK_BITS] + _offsets[v];
+}
+
+CompressedGraph::NeighborRange CompressedGraph::adj(int v) const
+{
+  const unsigned char *p = list(v);
+  int degree = static_cast<int>(read_varint(p));
+  return NeighborRange(p, degree, v);
+}
+
+// Degrees
+int CompressedGraph::degree(int v) const
+{
+  const unsigned char *p = list(v);
+  return static_cast<int>(read_varint(p));
+}
+
+// Memory
+std::size_t CompressedGraph::bytes() const
+{
+  return _bytes.size() + _anchors.size() * sizeof(long long) + _offsets.size() * sizeof(std::uint32_t);
+}
+
+double CompressedGraph::bytes_per_edge() const
+{
+  long long arcs = _directed ? _E : 2 * _E;
+  return arcs == 0 ? 0.0 : static_cast<double>(bytes()) / arcs;
+}
+
+// Decompression
+CSRGraph CompressedGraph::to_csr() const
+{
+  std::vector<long long> offsets(_V + 1, 0);
+  for (int v = 0; v < _V; v++)
+  {
+    offsets[v + 1] = offsets[v] + degree(v);
+  }
+
+  std::vector<int> targets(offsets[_V]);
+  parallel_for(0, _V, [&](long long v)
+               {
+    NeighborRange list = adj(v);
+    std::copy(list.begin(), list.end(), targets.begin() + offsets[v]); });
+
+  return CSRGraph(_V, std::move(offsets), std::move(targets), _directed);
+}
@@ -0,0 +1,168 @@
+/******************************************************************************
+ *  File: alg_connectivity.cpp
+ *
+ *  An implementation file of the incrementally connected graph.
+ ******************************************************************************/
+
+#include <algorithm>
+#include "alg_connectivity.h"
+
+/******************************************************************************
+ *  Class: ConnectedGraph
+ *  A Graph with a union-find kept in sync with its edges.
+ ******************************************************************************/
+// Unions the endpoints of every edge into a fresh union-find
+void ConnectedGraph::rebuild()
+{
+  uf = PackedPCWQuickUF(2 * _V);
+  label.resize(_V);
+  for (int v = 0; v < _V; v++)
+  {
+    label[v] = v;
+  }
+  next_label = _V;
+
+  for (int v = 0; v < _V; v++)
+  {
+    for (int w : _adj[v])
+    {
+      uf._union(v, w);
+    }
+  }
+}
+
+// Relabels every vertex by the first vertex of its component, freeing the
+// labels abandoned by splits
+void ConnectedGraph::compact()
+{
+  std::vector<int> first(2 * _V, -1); // By root label
+  PackedPCWQuickUF old = std::move(uf);
+  uf = PackedPCWQuickUF(2 * _V);
+  for (int x = 0; x < _V; x++)
+  {
+    int &f = first[old._find(label[x])];
+    if (f == -1)
+    {
+      f = x;
+    }
+    else
+    {
+      uf._union(f, x);
+    }
+    label[x] = x;
+  }
+  next_label = _V;
+}
+
+// Searches from v and w one vertex at a time each. Returns false if the
+// searches meet (v and w are still connected). Otherwise returns true with
+// the vertices of the side whose search finished first.
+bool ConnectedGraph::split_side(int v, int w, std::vector<int> &side)
+{
+  if (epoch >= (~0u >> 1) - 1)
+  {
+    std::fill(seen.begin(), seen.end(), 0);
+    epoch = 0;
+  }
+  epoch++;
+
+  std::vector<int> queue[2] = {{v}, {w}};
+  std::size_t head[2] = {0, 0};
+  seen[v] = 2 * epoch;
+  seen[w] = 2 * epoch + 1;
+
+  for (;;)
+  {
+    for (int s = 0; s < 2; s++)
+    {
+      if (head[s] == queue[s].size())
+      {
+        side.swap(queue[s]);
+        return true;
+      }
+
+      int x = queue[s][head[s]++];
+      for (int y : _adj[x])
+      {
+        if (seen[y] == 2 * epoch + (1 - s))
+        {
+          return false;
+        }
+
+        if (seen[y] != 2 * epoch + s)
+        {
+          seen[y] = 2 * epoch + s;
+          queue[s].push_back(y);
+        }
+      }
+    }
+  }
+}
+
+// Constructors
+ConnectedGraph::ConnectedGraph(int V) : Graph(V), uf(0), seen(V, 0)
+{
+  rebuild();
+}
+
+ConnectedGraph::ConnectedGraph(const Graph &g) : Graph(), uf(0)
+{
+  copy_graph(g);
+  seen.assign(_V, 0);
+  rebuild();
+}
+
+// The edges were replaced wholesale: start over from them
+void ConnectedGraph::adjacency_replaced()
+{
+  seen.assign(_V, 0);
+  epoch = 0;
+  rebuild();
+}
+
+// Adding/removing edges
+void ConnectedGraph::add_edge(int v, int w)
+{
+  Graph::add_edge(v, w);
+  uf._union(label[v], label[w]);
+}
+
+void ConnectedGraph::remove_edge(int v, int w)
+{
+  Graph::remove_edge(v, w);
+  if (v == w || _adj.contains(v, w))
+  {
+    return; // A self-loop or a parallel edge never disconnects anything
+  }
+
+  std::vector<int> side;
+  if (!split_side(v, w, side))
+  {
+    return;
+  }
+
+  // The searched side leaves its old label in the set of the rest
+  if (next_label == 2 * _V)
+  {
+    compact();
+  }
+
+  int fresh = next_label++;
+  for (int x : side)
+  {
+    label[x] = fresh;
+  }
+}
+
+// Connectivity
+bool ConnectedGraph::connected(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  return uf.connected(label[v], label[w]);
+}
+
+int ConnectedGraph::components_count() const
+{
+  return uf.components_count() - (2 * _V - next_label);
+}
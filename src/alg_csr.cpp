@@ -0,0 +1,415 @@
+/******************************************************************************
+ *  File: alg_csr.cpp
+ *
+ *  An implementation file of the compressed sparse row (CSR) graph.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "alg_csr.h"
+#include "alg_graph_io.h"
+
+/******************************************************************************
+ *  Class: CSRGraph
+ *  A read-only adjacency array.
+ ******************************************************************************/
+void CSRGraph::validate_vertex(int v) const
+{
+  if (v < 0 || v >= _V)
+  {
+    throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(_V - 1));
+  }
+}
+
+// Points the raw arrays at the owned storage unless this is a view
+void CSRGraph::attach()
+{
+  if (_mapping == nullptr)
+  {
+    _offsets = _offset_store.data();
+    _targets = _target_store.data();
+    _indegree = nullptr;
+  }
+}
+
+// Constructors
+CSRGraph::CSRGraph()
+{
+  attach();
+}
+
+CSRGraph::CSRGraph(const BaseGraph &g) : _V(g.V()), _E(g.E()), _directed(g.is_directed())
+{
+  _offset_store.assign(_V + 1, 0);
+  for (int v = 0; v < _V; v++)
+  {
+    _offset_store[v + 1] = _offset_store[v] + g._adj.size(v);
+  }
+
+  _target_store.resize(_offset_store[_V]);
+  for (int v = 0; v < _V; v++)
+  {
+    int *out = _target_store.data() + _offset_store[v];
+    g._adj.for_each(v, [&out](int w)
+                    { *out++ = w; });
+  }
+
+  attach();
+}
+
+CSRGraph::CSRGraph(int V, std::vector<long long> offsets, std::vector<int> targets, bool directed)
+    : _V(V), _directed(directed), _offset_store(std::move(offsets)), _target_store(std::move(targets))
+{
+  if (static_cast<int>(_offset_store.size()) != _V + 1 || _offset_store[_V] != static_cast<long long>(_target_store.size()))
+  {
+    throw std::runtime_error("CSR offsets do not match the number of vertices and targets");
+  }
+
+  attach();
+  _E = directed ? arcs() : arcs() / 2;
+}
+
+CSRGraph CSRGraph::from_edges(int V, const std::vector<std::pair<int, int>> &edges, bool directed)
+{
+  std::vector<long long> offsets(V + 1, 0);
+  for (auto [v, w] : edges)
+  {
+    if (v < 0 || v >= V || w < 0 || w >= V)
+    {
+      throw std::runtime_error("edge " + std::to_string(v) + "-" + std::to_string(w) + " is out of range");
+    }
+
+    offsets[v + 1]++;
+    if (!directed)
+    {
+      offsets[w + 1]++;
+    }
+  }
+
+  for (int v = 0; v < V; v++)
+  {
+    offsets[v + 1] += offsets[v];
+  }
+
+  std::vector<int> targets(offsets[V]);
+  std::vector<long long> cursor(offsets.begin(), offsets.end() - 1);
+  for (auto [v, w] : edges)
+  {
+    targets[cursor[v]++] = w;
+    if (!directed)
+    {
+      targets[cursor[w]++] = v;
+    }
+  }
+
+  return CSRGraph(V, std::move(offsets), std::move(targets), directed);
+}
+
+// Copy constructor and assignment operator
+CSRGraph::CSRGraph(const CSRGraph &g)
+    : _V(g._V), _E(g._E), _directed(g._directed), _offset_store(g._offset_store), _target_store(g._target_store),
+      _mapping(g._mapping), _offsets(g._offsets), _targets(g._targets), _indegree(g._indegree)
+{
+  attach();
+}
+
+CSRGraph &CSRGraph::operator=(const CSRGraph &g)
+{
+  if (this != &g)
+  {
+    CSRGraph copy(g);
+    *this = std::move(copy);
+  }
+
+  return *this;
+}
+
+// Move constructor and assignment operator
+CSRGraph::CSRGraph(CSRGraph &&g) noexcept
+    : _V(g._V), _E(g._E), _directed(g._directed), _offset_store(std::move(g._offset_store)),
+      _target_store(std::move(g._target_store)), _mapping(std::move(g._mapping)), _offsets(g._offsets),
+      _targets(g._targets), _indegree(g._indegree)
+{
+  attach();
+  g._V = 0;
+  g._E = 0;
+  g._offset_store.assign(1, 0);
+  g._target_store.clear();
+  g.attach();
+}
+
+CSRGraph &CSRGraph::operator=(CSRGraph &&g) noexcept
+{
+  if (this != &g)
+  {
+    _V = g._V;
+    _E = g._E;
+    _directed = g._directed;
+    _offset_store = std::move(g._offset_store);
+    _target_store = std::move(g._target_store);
+    _mapping = std::move(g._mapping);
+    _offsets = g._offsets;
+    _targets = g._targets;
+    _indegree = g._indegree;
+    attach();
+
+    g._V = 0;
+    g._E = 0;
+    g._offset_store.assign(1, 0);
+    g._target_store.clear();
+    g.attach();
+  }
+
+  return *this;
+}
+
+// Vertices and edges
+int CSRGraph::V() const { return _V; }
+
+long long CSRGraph::E() const { return _E; }
+
+long long CSRGraph::arcs() const { return _offsets[_V]; }
+
+bool CSRGraph::is_directed() const { return _directed; }
+
+bool CSRGraph::is_view() const { return _mapping != nullptr; }
+
+bool CSRGraph::edge(int v, int w) const
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  auto list = adj(v);
+  return std::find(list.begin(), list.end(), w) != list.end();
+}
+
+std::span<const int> CSRGraph::adj(int v) const
+{
+  return std::span<const int>(_targets + _offsets[v], _targets + _offsets[v + 1]);
+}
+
+// Degrees
+int CSRGraph::degree(int v) const
+{
+  return static_cast<int>(_offsets[v + 1] - _offsets[v]);
+}
+
+std::vector<int> CSRGraph::in_degrees() const
+{
+  if (_indegree != nullptr)
+  {
+    return std::vector<int>(_indegree, _indegree + _V);
+  }
+
+  std::vector<int> indegree(_V, 0);
+  for (int w : targets())
+  {
+    indegree[w]++;
+  }
+
+  return indegree;
+}
+
+// Raw arrays
+std::span<const long long> CSRGraph::offsets() const
+{
+  return std::span<const long long>(_offsets, _V + 1);
+}
+
+std::span<const int> CSRGraph::targets() const
+{
+  return std::span<const int>(_targets, arcs());
+}
+
+// Reversing
+CSRGraph CSRGraph::transpose() const
+{
+  if (!_directed)
+  {
+    return *this;
+  }
+
+  std::vector<long long> offsets(_V + 1, 0);
+  for (int w : targets())
+  {
+    offsets[w + 1]++;
+  }
+
+  for (int v = 0; v < _V; v++)
+  {
+    offsets[v + 1] += offsets[v];
+  }
+
+  // Scanning sources in order keeps every reversed list sorted by source
+  std::vector<int> targets(arcs());
+  std::vector<long long> cursor(offsets.begin(), offsets.end() - 1);
+  for (int v = 0; v < _V; v++)
+  {
+    for (int w : adj(v))
+    {
+      targets[cursor[w]++] = v;
+    }
+  }
+
+  return CSRGraph(_V, std::move(offsets), std::move(targets), true);
+}
+
+// Binary files
+void CSRGraph::save_binary(const std::string &path, bool with_indegree) const
+{
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    throw std::runtime_error("Unable to open file " + path + " for writing");
+  }
+
+  with_indegree = with_indegree && _directed;
+  BinaryGraphHeader header;
+  std::memcpy(header.magic, BinaryGraphHeader::MAGIC, sizeof(header.magic));
+  header.version = BinaryGraphHeader::VERSION;
+  header.flags = (_directed ? BinaryGraphHeader::DIRECTED : 0) | (with_indegree ? BinaryGraphHeader::HAS_INDEGREE : 0);
+  header.V = _V;
+  header.E = _E;
+  header.arcs = arcs();
+  header.offsets_at = sizeof(BinaryGraphHeader);
+  header.targets_at = header.offsets_at + (header.V + 1) * sizeof(long long);
+  long long targets_end = header.targets_at + header.arcs * sizeof(int);
+  header.indegree_at = with_indegree ? (targets_end + 7) / 8 * 8 : 0;
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(_offsets), (_V + 1) * sizeof(long long));
+  out.write(reinterpret_cast<const char *>(_targets), arcs() * sizeof(int));
+  if (with_indegree)
+  {
+    const char padding[8] = {0};
+    out.write(padding, header.indegree_at - targets_end);
+    std::vector<int> indegree = in_degrees();
+    out.write(reinterpret_cast<const char *>(indegree.data()), _V * sizeof(int));
+  }
+
+  if (!out)
+  {
+    throw std::runtime_error("Unable to write file " + path);
+  }
+}
+
+CSRGraph CSRGraph::load_binary(const std::string &path, bool verify)
+{
+  auto file = std::make_shared<const MappedFile>(path, false);
+  BinaryGraphHeader header;
+  if (file->size() < sizeof(header))
+  {
+    throw std::runtime_error("File " + path + " is too small to be a binary graph");
+  }
+
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, BinaryGraphHeader::MAGIC, sizeof(header.magic)) != 0)
+  {
+    throw std::runtime_error("File " + path + " is not a binary graph");
+  }
+
+  if (header.version != BinaryGraphHeader::VERSION)
+  {
+    throw std::runtime_error("Binary graph " + path + " has unsupported version " + std::to_string(header.version) +
+                             " (or was written with a different byte order)");
+  }
+
+  // Whether count aligned entries of the given width start at byte `at`
+  // and end inside the file; written so that nothing can overflow
+  bool has_indegree = header.flags & BinaryGraphHeader::HAS_INDEGREE;
+  long long size = file->size();
+  auto fits = [size](long long at, long long count, long long width)
+  {
+    return at >= 0 && at <= size && at % width == 0 && count <= (size - at) / width;
+  };
+
+  bool directed = header.flags & BinaryGraphHeader::DIRECTED;
+  if (header.V < 0 || header.V > INT32_MAX || header.arcs < 0 ||
+      !fits(header.offsets_at, header.V + 1, 8) || !fits(header.targets_at, header.arcs, 4) ||
+      (has_indegree && !fits(header.indegree_at, header.V, 4)))
+  {
+    throw std::runtime_error("Binary graph " + path + " is truncated or corrupt");
+  }
+
+  if (directed ? header.E != header.arcs : header.arcs % 2 != 0 || header.E != header.arcs / 2)
+  {
+    throw std::runtime_error("Binary graph " + path + " has " + std::to_string(header.E) + " edges but " +
+                             std::to_string(header.arcs) + " arcs");
+  }
+
+  CSRGraph g;
+  g._V = static_cast<int>(header.V);
+  g._E = header.E;
+  g._directed = directed;
+  g._offsets = reinterpret_cast<const long long *>(file->data() + header.offsets_at);
+  g._targets = reinterpret_cast<const int *>(file->data() + header.targets_at);
+  g._indegree = has_indegree ? reinterpret_cast<const int *>(file->data() + header.indegree_at) : nullptr;
+  g._mapping = std::move(file);
+
+  // Only the two ends of the offsets are checked here; the rest of the file
+  // is trusted unless verify asks for the full O(V + E) scan
+  if (g._offsets[0] != 0 || g._offsets[g._V] != header.arcs)
+  {
+    throw std::runtime_error("Binary graph " + path + " has inconsistent offsets");
+  }
+
+  if (verify)
+  {
+    g.validate();
+  }
+
+  return g;
+}
+
+void CSRGraph::validate() const
+{
+  const long long arcs = _offsets[_V];
+  if (_offsets[0] != 0)
+  {
+    throw std::runtime_error("CSRGraph has inconsistent offsets");
+  }
+
+  for (int v = 0; v < _V; v++)
+  {
+    if (_offsets[v + 1] < _offsets[v] || _offsets[v + 1] > arcs)
+    {
+      throw std::runtime_error("CSRGraph has inconsistent offsets at vertex " + std::to_string(v));
+    }
+  }
+
+  for (long long i = 0; i < arcs; i++)
+  {
+    if (_targets[i] < 0 || _targets[i] >= _V)
+    {
+      throw std::runtime_error("CSRGraph has a target out of range at arc " + std::to_string(i));
+    }
+  }
+}
+
+// Input/output
+std::string CSRGraph::str() const
+{
+  std::ostringstream sout;
+  sout << *this;
+  return sout.str();
+}
+
+std::ostream &operator<<(std::ostream &out, const CSRGraph &g)
+{
+  out << g._V << std::endl
+      << g._E << std::endl;
+  for (int v = 0; v < g._V; v++)
+  {
+    out << v << ": ";
+    for (int w : g.adj(v))
+    {
+      out << w << " ";
+    }
+
+    out << std::endl;
+  }
+
+  return out;
+}
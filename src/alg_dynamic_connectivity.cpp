@@ -0,0 +1,180 @@
+/******************************************************************************
+ *  File: alg_dynamic_connectivity.cpp
+ *
+ *  An implementation file of offline dynamic connectivity.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "alg_dynamic_connectivity.h"
+
+/******************************************************************************
+ *  Class: OfflineDynamicConnectivity
+ *  Connectivity queries over a timeline of edge updates, answered offline.
+ ******************************************************************************/
+OfflineDynamicConnectivity::OfflineDynamicConnectivity(int V) : _V(V)
+{
+  if (V < 0)
+  {
+    throw std::runtime_error("Number of vertices must be nonnegative");
+  }
+}
+
+void OfflineDynamicConnectivity::validate_vertex(int v) const
+{
+  if (v < 0 || v >= _V)
+  {
+    throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(_V - 1));
+  }
+}
+
+// The same key for v-w and w-v
+std::uint64_t OfflineDynamicConnectivity::key(int v, int w)
+{
+  return static_cast<std::uint64_t>(std::min(v, w)) << 32 | static_cast<std::uint32_t>(std::max(v, w));
+}
+
+int OfflineDynamicConnectivity::V() const { return _V; }
+
+int OfflineDynamicConnectivity::queries_count() const { return static_cast<int>(queries.size()); }
+
+void OfflineDynamicConnectivity::add_edge(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  int *list = live.find(key(v, w));
+  if (list == nullptr)
+  {
+    live.insert(key(v, w), static_cast<int>(starts.size()));
+    starts.emplace_back();
+    list = live.find(key(v, w));
+  }
+
+  starts[*list].push_back(queries_count());
+}
+
+void OfflineDynamicConnectivity::remove_edge(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  int *list = live.find(key(v, w));
+  if (list == nullptr || starts[*list].empty())
+  {
+    throw std::runtime_error("Edge " + std::to_string(v) + "-" + std::to_string(w) + " is not in the graph");
+  }
+
+  int from = starts[*list].back();
+  starts[*list].pop_back();
+  if (from < queries_count())
+  {
+    intervals.push_back({v, w, from, queries_count()});
+  }
+}
+
+int OfflineDynamicConnectivity::query(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  queries.push_back({v, w});
+  return queries_count() - 1;
+}
+
+// Adds the edges of node, answers the query of a leaf or recurses, then
+// undoes the unions
+void OfflineDynamicConnectivity::solve(int node, int lo, int hi, const std::vector<std::vector<int>> &tree,
+                                       const std::vector<Interval> &all, RollbackUF &uf)
+{
+  std::size_t mark = uf.snapshot();
+  for (int i : tree[node])
+  {
+    uf._union(all[i].v, all[i].w);
+  }
+
+  if (hi - lo == 1)
+  {
+    answers[lo] = uf.connected(queries[lo].first, queries[lo].second);
+    components[lo] = uf.components_count();
+  }
+  else
+  {
+    int mid = lo + (hi - lo) / 2;
+    solve(2 * node, lo, mid, tree, all, uf);
+    solve(2 * node + 1, mid, hi, tree, all, uf);
+  }
+
+  uf.rollback(mark);
+}
+
+void OfflineDynamicConnectivity::solve()
+{
+  int Q = queries_count();
+  answers.assign(Q, 0);
+  components.assign(Q, 0);
+  if (Q == 0)
+  {
+    return;
+  }
+
+  // Edges still alive last until the end of the timeline
+  std::vector<Interval> all = intervals;
+  live.for_each([&](std::uint64_t k, int list)
+                {
+    for (int from : starts[list])
+    {
+      if (from < Q)
+      {
+        all.push_back({static_cast<int>(k >> 32), static_cast<int>(k & 0xffffffffu), from, Q});
+      }
+    } });
+
+  // Each interval lands on O(log Q) nodes covering it exactly
+  std::vector<std::vector<int>> tree(4 * static_cast<std::size_t>(Q));
+  for (int i = 0; i < static_cast<int>(all.size()); i++)
+  {
+    std::vector<std::pair<int, std::pair<int, int>>> stack = {{1, {0, Q}}};
+    while (!stack.empty())
+    {
+      auto [node, range] = stack.back();
+      auto [lo, hi] = range;
+      stack.pop_back();
+      if (all[i].to <= lo || hi <= all[i].from)
+      {
+        continue;
+      }
+
+      if (all[i].from <= lo && hi <= all[i].to)
+      {
+        tree[node].push_back(i);
+        continue;
+      }
+
+      int mid = lo + (hi - lo) / 2;
+      stack.push_back({2 * node, {lo, mid}});
+      stack.push_back({2 * node + 1, {mid, hi}});
+    }
+  }
+
+  RollbackUF uf(_V);
+  solve(1, 0, Q, tree, all, uf);
+}
+
+bool OfflineDynamicConnectivity::connected(int query) const
+{
+  if (query < 0 || query >= static_cast<int>(answers.size()))
+  {
+    throw std::runtime_error("Query " + std::to_string(query) + " has not been solved");
+  }
+
+  return answers[query];
+}
+
+int OfflineDynamicConnectivity::components_count(int query) const
+{
+  if (query < 0 || query >= static_cast<int>(components.size()))
+  {
+    throw std::runtime_error("Query " + std::to_string(query) + " has not been solved");
+  }
+
+  return components[query];
+}
@@ -0,0 +1,232 @@
+/******************************************************************************
+ *  File: alg_dynamic_graph.cpp
+ *
+ *  An implementation file of the streaming-update graph.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include "alg_dynamic_graph.h"
+
+/******************************************************************************
+ *  Class: DynamicGraph
+ *  A simple graph with swap-with-last deletions.
+ ******************************************************************************/
+std::uint64_t DynamicGraph::key(int v, int w)
+{
+  return (static_cast<std::uint64_t>(v) << 32) | static_cast<std::uint32_t>(w);
+}
+
+void DynamicGraph::validate_vertex(int v) const
+{
+  if (v < 0 || v >= _V)
+  {
+    throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(_V - 1));
+  }
+}
+
+bool DynamicGraph::add_arc(int v, int w)
+{
+  if (!position.insert(key(v, w), static_cast<int>(_adj[v].size())))
+  {
+    return false;
+  }
+
+  _adj[v].push_back(w);
+  return true;
+}
+
+bool DynamicGraph::remove_arc(int v, int w)
+{
+  int *at = position.find(key(v, w));
+  if (at == nullptr)
+  {
+    return false;
+  }
+
+  std::vector<int> &list = _adj[v];
+  int last = list.back();
+  if (last != w)
+  {
+    list[*at] = last;
+    *position.find(key(v, last)) = *at;
+  }
+
+  list.pop_back();
+  position.erase(key(v, w));
+  return true;
+}
+
+// Applies one kind of update to a batch of edges. Arcs are sorted by source
+// so consecutive updates touch the same neighbor list. Returns the number of
+// edges changed.
+long long DynamicGraph::apply_arcs(const std::vector<std::pair<int, int>> &edges, bool insert)
+{
+  std::vector<std::uint64_t> arcs;
+  arcs.reserve(_directed ? edges.size() : 2 * edges.size());
+  for (auto [v, w] : edges)
+  {
+    arcs.push_back(key(v, w));
+    if (!_directed && v != w)
+    {
+      arcs.push_back(key(w, v));
+    }
+  }
+  std::sort(arcs.begin(), arcs.end());
+
+  if (insert)
+  {
+    position.reserve(position.size() + arcs.size());
+  }
+
+  long long changed = 0;
+  for (std::size_t i = 0; i < arcs.size();)
+  {
+    int v = static_cast<int>(arcs[i] >> 32);
+    std::size_t group = i;
+    while (group < arcs.size() && static_cast<int>(arcs[group] >> 32) == v)
+    {
+      group++;
+    }
+
+    if (insert)
+    {
+      _adj[v].reserve(_adj[v].size() + (group - i));
+    }
+
+    for (; i < group; i++)
+    {
+      int w = static_cast<int>(arcs[i] & 0xffffffff);
+      bool done = insert ? add_arc(v, w) : remove_arc(v, w);
+
+      // Undirected edges are counted once, at their smaller endpoint
+      if (done && (_directed || v <= w))
+      {
+        changed++;
+      }
+    }
+  }
+
+  _E += insert ? changed : -changed;
+  return changed;
+}
+
+// Constructors
+DynamicGraph::DynamicGraph(int V, bool directed) : _V(V), _directed(directed), _adj(V) {}
+
+DynamicGraph::DynamicGraph(const CSRGraph &g) : DynamicGraph(g.V(), g.is_directed())
+{
+  position.reserve(g.arcs());
+  for (int v = 0; v < _V; v++)
+  {
+    _adj[v].reserve(g.degree(v));
+    for (int w : g.adj(v))
+    {
+      if (add_arc(v, w) && (_directed || v <= w))
+      {
+        _E++;
+      }
+    }
+  }
+}
+
+// Vertices and edges
+int DynamicGraph::V() const { return _V; }
+
+long long DynamicGraph::E() const { return _E; }
+
+bool DynamicGraph::is_directed() const { return _directed; }
+
+bool DynamicGraph::edge(int v, int w) const
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  return position.find(key(v, w)) != nullptr;
+}
+
+std::span<const int> DynamicGraph::adj(int v) const
+{
+  validate_vertex(v);
+  return _adj[v];
+}
+
+// Degrees
+int DynamicGraph::degree(int v) const
+{
+  validate_vertex(v);
+  return static_cast<int>(_adj[v].size());
+}
+
+// Adding/removing edges
+bool DynamicGraph::add_edge(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  if (!add_arc(v, w))
+  {
+    return false;
+  }
+
+  if (!_directed && v != w)
+  {
+    add_arc(w, v);
+  }
+
+  _E++;
+  return true;
+}
+
+bool DynamicGraph::remove_edge(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  if (!remove_arc(v, w))
+  {
+    return false;
+  }
+
+  if (!_directed && v != w)
+  {
+    remove_arc(w, v);
+  }
+
+  _E--;
+  return true;
+}
+
+long long DynamicGraph::apply_batch(const std::vector<std::pair<int, int>> &inserts,
+                                    const std::vector<std::pair<int, int>> &deletes)
+{
+  for (const std::vector<std::pair<int, int>> *batch : {&inserts, &deletes})
+  {
+    for (auto [v, w] : *batch)
+    {
+      if (static_cast<unsigned>(v) >= static_cast<unsigned>(_V) || static_cast<unsigned>(w) >= static_cast<unsigned>(_V))
+      {
+        validate_vertex(v);
+        validate_vertex(w);
+      }
+    }
+  }
+
+  long long changed = apply_arcs(deletes, false);
+  return changed + apply_arcs(inserts, true);
+}
+
+CSRGraph DynamicGraph::to_csr() const
+{
+  std::vector<long long> offsets(_V + 1, 0);
+  for (int v = 0; v < _V; v++)
+  {
+    offsets[v + 1] = offsets[v] + _adj[v].size();
+  }
+
+  std::vector<int> targets;
+  targets.reserve(offsets[_V]);
+  for (const std::vector<int> &list : _adj)
+  {
+    targets.insert(targets.end(), list.begin(), list.end());
+  }
+
+  return CSRGraph(_V, std::move(offsets), std::move(targets), _directed);
+}
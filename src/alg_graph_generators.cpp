@@ -0,0 +1,321 @@
+/******************************************************************************
+ *  File: alg_graph_generators.cpp
+ *
+ *  An implementation file of the synthetic graph generators.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "alg_graph_generators.h"
+#include "alg_graph_io.h"
+#include "alg_hash.h"
+#include "alg_parallel.h"
+
+/******************************************************************************
+ *  Helpers
+ ******************************************************************************/
+static const long long CHUNK = 1 << 16; // Edges (or rows) per random stream
+
+// The random stream of one chunk of one generator run
+static std::mt19937_64 stream(std::uint64_t seed, std::uint64_t round, std::uint64_t chunk)
+{
+  return std::mt19937_64(hash_mix(hash_mix(seed ^ hash_mix(round)) + chunk));
+}
+
+static double uniform(std::mt19937_64 &rng)
+{
+  return (rng() >> 11) * 0x1.0p-53;
+}
+
+// Generates `count` edges into edges[first ..], chunk by chunk
+template <class F>
+static void generate_chunks(std::vector<std::pair<int, int>> &edges, long long first, long long count,
+                            std::uint64_t seed, std::uint64_t round, int threads, F &&edge)
+{
+  long long chunks = (count + CHUNK - 1) / CHUNK;
+  parallel_for(
+      0, chunks, [&](long long k)
+      {
+        std::mt19937_64 rng = stream(seed, round, k);
+        for (long long i = k * CHUNK; i < std::min(count, (k + 1) * CHUNK); i++)
+        {
+          edges[first + i] = edge(rng);
+        } },
+      threads, 1);
+}
+
+// Sorts edges and drops duplicates, in parallel. Every thread scatters its
+// block of edges into ranges of source vertices (counted first, as in a
+// radix sort pass); each range is then sorted and deduplicated on its own
+// and the ranges are packed back in order, giving the same result as one
+// global sort.
+static void sort_unique(std::vector<std::pair<int, int>> &edges, int V, int threads)
+{
+  threads = resolve_threads(threads);
+  const long long n = edges.size();
+  const int ranges = std::max(1, std::min(V, 8 * threads));
+  const long long block = (n + threads - 1) / threads;
+  auto range_of = [V, ranges](int v)
+  {
+    return static_cast<int>(static_cast<long long>(v) * ranges / V);
+  };
+
+  // count[t * ranges + r]: edges of range r in the block of thread t
+  std::vector<long long> count(static_cast<long long>(threads) * ranges, 0);
+  parallel_run(threads, [&](int tid)
+               {
+    for (long long i = tid * block; i < std::min(n, (tid + 1) * block); i++)
+    {
+      count[tid * ranges + range_of(edges[i].first)]++;
+    } });
+
+  std::vector<long long> start(ranges + 1);
+  long long at = 0;
+  for (int r = 0; r < ranges; r++)
+  {
+    start[r] = at;
+    for (int t = 0; t < threads; t++)
+    {
+      long long c = count[t * ranges + r];
+      count[t * ranges + r] = at;
+      at += c;
+    }
+  }
+  start[ranges] = n;
+
+  std::vector<std::pair<int, int>> buffer(n);
+  parallel_run(threads, [&](int tid)
+               {
+    for (long long i = tid * block; i < std::min(n, (tid + 1) * block); i++)
+    {
+      buffer[count[tid * ranges + range_of(edges[i].first)]++] = edges[i];
+    } });
+
+  std::vector<long long> kept(ranges + 1, 0);
+  parallel_for(
+      0, ranges, [&](long long r)
+      {
+        auto first = buffer.begin() + start[r];
+        auto last = buffer.begin() + start[r + 1];
+        std::sort(first, last);
+        kept[r + 1] = std::unique(first, last) - first; },
+      threads, 1);
+
+  for (int r = 0; r < ranges; r++)
+  {
+    kept[r + 1] += kept[r];
+  }
+
+  edges.resize(kept[ranges]);
+  parallel_for(
+      0, ranges, [&](long long r)
+      {
+        std::copy(buffer.begin() + start[r], buffer.begin() + start[r] + (kept[r + 1] - kept[r]),
+                  edges.begin() + kept[r]); },
+      threads, 1);
+}
+
+/******************************************************************************
+ *  Struct: GeneratedGraph
+ *  An edge list with its vertex count.
+ ******************************************************************************/
+CSRGraph GeneratedGraph::to_csr() const
+{
+  return CSRGraph::from_edges(V, edges, directed);
+}
+
+void GeneratedGraph::fill(BaseGraph &g) const
+{
+  GraphLoader::fill(to_csr(), g);
+}
+
+void GeneratedGraph::save_binary(const std::string &path) const
+{
+  to_csr().save_binary(path);
+}
+
+/******************************************************************************
+ *  Class: GraphGenerator
+ *  Seeded, multi-threaded generators.
+ ******************************************************************************/
+GeneratedGraph GraphGenerator::rmat(int scale, long long edges, std::uint64_t seed, bool directed, int threads,
+                                    double a, double b, double c)
+{
+  if (scale < 0 || scale > 30 || edges < 0)
+  {
+    throw std::runtime_error("R-MAT needs 0 <= scale <= 30 and a non-negative edge count");
+  }
+
+  if (a < 0 || b < 0 || c < 0 || a + b + c > 1)
+  {
+    throw std::runtime_error("R-MAT quadrant probabilities must be non-negative and add up to at most 1");
+  }
+
+  GeneratedGraph g;
+  g.V = 1 << scale;
+  g.directed = directed;
+  g.edges.resize(edges);
+
+  // An odd multiplier and an offset modulo 2^scale make a bijection
+  const std::uint64_t mask = g.V - 1;
+  const std::uint64_t multiplier = hash_mix(seed) | 1, offset = hash_mix(seed + 1);
+  auto scramble = [&](std::uint64_t v)
+  {
+    return static_cast<int>((v * multiplier + offset) & mask);
+  };
+
+  generate_chunks(g.edges, 0, edges, seed, 0, threads, [&](std::mt19937_64 &rng)
+                  {
+    std::uint64_t v = 0, w = 0;
+    for (int level = 0; level < scale; level++)
+    {
+      double r = uniform(rng);
+      v = 2 * v + (r >= a + b);
+      w = 2 * w + ((r >= a && r < a + b) || r >= a + b + c);
+    }
+    return std::pair<int, int>(scramble(v), scramble(w)); });
+
+  return g;
+}
+
+GeneratedGraph GraphGenerator::gnp(int V, double p, std::uint64_t seed, bool directed, int threads)
+{
+  if (V < 0 || p < 0 || p > 1)
+  {
+    throw std::runtime_error("G(n, p) needs V >= 0 and 0 <= p <= 1");
+  }
+
+  GeneratedGraph g;
+  g.V = V;
+  g.directed = directed;
+  if (p == 0)
+  {
+    return g;
+  }
+
+  // Rows are split into chunks of equally many rows. Undirected rows have
+  // fewer candidates the higher v is, so chunks are unequal then; the
+  // dynamic scheduling of parallel_for evens that out.
+  const long long rows = std::max(1LL, CHUNK / std::max(1, V));
+  const long long chunks = (V + rows - 1) / rows;
+  const double log_q = std::log1p(-p);
+  std::vector<std::vector<std::pair<int, int>>> parts(chunks);
+  parallel_for(
+      0, chunks, [&](long long k)
+      {
+        std::mt19937_64 rng = stream(seed, 0, k);
+        std::vector<std::pair<int, int>> &part = parts[k];
+        for (long long v = k * rows; v < std::min<long long>(V, (k + 1) * rows); v++)
+        {
+          // Candidates of v: every w != v, or every w > v if undirected
+          long long candidates = directed ? V - 1 : V - 1 - v;
+          for (long long i = -1;;)
+          {
+            // The geometric skip stays a double until it is known to land
+            // inside the row; for tiny p it can exceed any long long
+            double skip = p == 1 ? 0 : std::floor(std::log1p(-uniform(rng)) / log_q);
+            if (skip >= static_cast<double>(candidates - 1 - i))
+            {
+              break;
+            }
+
+            i += 1 + static_cast<long long>(skip);
+
+            long long w = directed ? (i < v ? i : i + 1) : v + 1 + i;
+            part.push_back({static_cast<int>(v), static_cast<int>(w)});
+          }
+        } },
+      threads, 1);
+
+  for (const auto &part : parts)
+  {
+    g.edges.insert(g.edges.end(), part.begin(), part.end());
+  }
+
+  return g;
+}
+
+GeneratedGraph GraphGenerator::gnm(int V, long long edges, std::uint64_t seed, bool directed, int threads)
+{
+  long long possible = directed ? static_cast<long long>(V) * (V - 1) : static_cast<long long>(V) * (V - 1) / 2;
+  if (V < 0 || edges < 0 || edges > possible)
+  {
+    throw std::runtime_error("G(n, m) needs 0 <= edges <= the number of possible edges");
+  }
+
+  GeneratedGraph g;
+  g.V = V;
+  g.directed = directed;
+  g.edges.reserve(edges);
+
+  // Draw the missing number of edges, drop duplicates, and repeat
+  for (std::uint64_t round = 0; static_cast<long long>(g.edges.size()) < edges; round++)
+  {
+    long long first = g.edges.size(), missing = edges - first;
+    g.edges.resize(edges);
+    generate_chunks(g.edges, first, missing, seed, round, threads, [&](std::mt19937_64 &rng)
+                    {
+      std::uniform_int_distribution<int> vertex(0, V - 1);
+      int v = vertex(rng), w;
+      do
+      {
+        w = vertex(rng);
+      } while (w == v);
+      return directed ? std::pair<int, int>(v, w) : std::pair<int, int>(std::min(v, w), std::max(v, w)); });
+
+    sort_unique(g.edges, V, threads);
+  }
+
+  return g;
+}
+
+GeneratedGraph GraphGenerator::grid(int rows, int cols, bool directed, int threads)
+{
+  if (rows < 0 || cols < 0 || static_cast<long long>(rows) * cols > INT32_MAX)
+  {
+    throw std::runtime_error("Grid dimensions are negative or too large");
+  }
+
+  GeneratedGraph g;
+  g.V = rows * cols;
+  g.directed = directed;
+  if (g.V == 0)
+  {
+    return g;
+  }
+
+  // Row r owns its cols - 1 horizontal edges, then cols vertical ones
+  const long long per_row = 2LL * cols - 1;
+  g.edges.resize(per_row * rows - cols);
+  parallel_for(
+      0, rows, [&](long long r)
+      {
+        int base = static_cast<int>(r * cols);
+        long long at = r * per_row;
+        for (int c = 0; c + 1 < cols; c++)
+        {
+          g.edges[at++] = {base + c, base + c + 1};
+        }
+        for (int c = 0; c < cols && r + 1 < rows; c++)
+        {
+          g.edges[at++] = {base + c, base + cols + c};
+        } },
+      threads, 64);
+
+  return g;
+}
+
+GeneratedGraph GraphGenerator::chain(int V, bool directed)
+{
+  GeneratedGraph g;
+  g.V = std::max(V, 0);
+  g.directed = directed;
+  for (int v = 0; v + 1 < V; v++)
+  {
+    g.edges.push_back({v, v + 1});
+  }
+
+  return g;
+}
@@ -0,0 +1,433 @@
+/******************************************************************************
+ *  File: alg_graph_io.cpp
+ *
+ *  An implementation file of the fast graph file loaders.
+ ******************************************************************************/
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "alg_graph_io.h"
+#include "alg_parallel.h"
+
+/******************************************************************************
+ *  Class: MappedFile
+ *  A read-only memory mapping of a whole file.
+ ******************************************************************************/
+MappedFile::MappedFile(const std::string &path, bool sequential)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Unable to open file " + path);
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    throw std::runtime_error("Unable to stat file " + path);
+  }
+
+  _size = static_cast<std::size_t>(st.st_size);
+  if (_size != 0)
+  {
+    void *p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED)
+    {
+      ::close(fd);
+      throw std::runtime_error("Unable to map file " + path);
+    }
+
+    if (sequential)
+    {
+      ::madvise(p, _size, MADV_SEQUENTIAL);
+    }
+    _data = static_cast<const char *>(p);
+  }
+
+  ::close(fd);
+}
+
+const char *MappedFile::data() const { return _data; }
+
+std::size_t MappedFile::size() const { return _size; }
+
+MappedFile::~MappedFile() noexcept
+{
+  if (_data != nullptr)
+  {
+    ::munmap(const_cast<char *>(_data), _size);
+  }
+}
+
+/******************************************************************************
+ *  Parsing helpers
+ ******************************************************************************/
+static inline bool is_digit(char c)
+{
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+static inline const char *skip_blanks(const char *p, const char *end)
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+  {
+    p++;
+  }
+
+  return p;
+}
+
+// Reads an unsigned decimal integer; p must point at its first digit.
+// Values too large for a long long saturate to LLONG_MAX, which every
+// caller rejects as out of range.
+static inline const char *parse_int(const char *p, const char *end, long long &x)
+{
+  x = 0;
+  for (unsigned d; p < end && (d = static_cast<unsigned char>(*p - '0')) < 10; p++)
+  {
+    x = x > (LLONG_MAX - d) / 10 ? LLONG_MAX : x * 10 + d;
+  }
+
+  return p;
+}
+
+static inline const char *line_end(const char *p, const char *end)
+{
+  const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+  return eol == nullptr ? end : eol;
+}
+
+// Reads the first `count` integers of the file (the header) and returns the
+// start of the line that follows them.
+static const char *parse_header(const MappedFile &file, long long *values, int count, const std::string &path)
+{
+  const char *p = file.data(), *end = p + file.size();
+  for (int i = 0; i < count; i++)
+  {
+    while (p < end && !is_digit(*p))
+    {
+      p++;
+    }
+
+    if (p == end)
+    {
+      throw std::runtime_error("Missing header in graph file " + path);
+    }
+
+    p = parse_int(p, end, values[i]);
+  }
+
+  p = line_end(p, end);
+  return p == end ? end : p + 1;
+}
+
+// Cuts [begin, end) into `parts` pieces that start at line beginnings
+static std::vector<const char *> split_lines(const char *begin, const char *end, int parts)
+{
+  std::vector<const char *> bounds(parts + 1, end);
+  bounds[0] = begin;
+  for (int i = 1; i < parts; i++)
+  {
+    const char *p = begin + (end - begin) * i / parts;
+    if (p <= bounds[i - 1])
+    {
+      bounds[i] = bounds[i - 1];
+      continue;
+    }
+
+    p = line_end(p - 1, end);
+    bounds[i] = p == end ? end : p + 1;
+  }
+
+  return bounds;
+}
+
+// Calls visit(v, first, last) for every "v: w1 w2 ..." line in [p, end), where
+// [first, last) is the text of the neighbor list.
+template <class F>
+static void for_each_adjacency_line(const char *p, const char *end, F &&visit)
+{
+  while (p < end)
+  {
+    const char *eol = line_end(p, end);
+    p = skip_blanks(p, eol);
+    if (p < eol && is_digit(*p))
+    {
+      long long v;
+      p = skip_blanks(parse_int(p, eol, v), eol);
+      if (p < eol && *p == ':')
+      {
+        visit(v, p + 1, eol);
+      }
+    }
+
+    p = eol + 1;
+  }
+}
+
+// Parses the whitespace-separated integers of [p, end) into out. Returns
+// false on any other character or on an integer not in [0, V).
+static bool parse_list(const char *p, const char *end, int V, std::vector<int> &out)
+{
+  out.clear();
+  for (p = skip_blanks(p, end); p < end; p = skip_blanks(p, end))
+  {
+    if (!is_digit(*p))
+    {
+      return false;
+    }
+
+    long long w;
+    p = parse_int(p, end, w);
+    if (w >= V)
+    {
+      return false;
+    }
+
+    out.push_back(static_cast<int>(w));
+  }
+
+  return true;
+}
+
+// Calls visit(v, w) for the leading pair of every non-blank line in [p, end)
+template <class F>
+static bool for_each_pair(const char *p, const char *end, F &&visit)
+{
+  while (p < end)
+  {
+    const char *eol = line_end(p, end);
+    p = skip_blanks(p, eol);
+    if (p < eol)
+    {
+      long long v, w;
+      if (!is_digit(*p))
+      {
+        return false;
+      }
+
+      p = skip_blanks(parse_int(p, eol, v), eol);
+      if (p == eol || !is_digit(*p))
+      {
+        return false;
+      }
+
+      parse_int(p, eol, w);
+      visit(v, w);
+    }
+
+    p = eol + 1;
+  }
+
+  return true;
+}
+
+// The vertex count of a file header, which must fit the int vertex ids
+static int header_vertices(long long V, const std::string &path)
+{
+  if (V > INT32_MAX - 1)
+  {
+    throw std::runtime_error("Too many vertices in the header of graph file " + path);
+  }
+
+  return static_cast<int>(V);
+}
+
+static int chunk_count(std::size_t bytes, int threads)
+{
+  // Several chunks per thread so a dense region does not stall one thread
+  long long chunks = threads == 1 ? 1 : 4LL * threads;
+  return static_cast<int>(std::max<long long>(1, std::min<long long>(chunks, bytes / 4096 + 1)));
+}
+
+static void prefix_sums(std::vector<long long> &offsets)
+{
+  for (std::size_t v = 1; v < offsets.size(); v++)
+  {
+    offsets[v] += offsets[v - 1];
+  }
+}
+
+/******************************************************************************
+ *  Class: GraphLoader
+ *  Fast loaders for adjacency-list and edge-list files.
+ ******************************************************************************/
+CSRGraph GraphLoader::load_adjacency(const std::string &path, bool directed, int threads)
+{
+  MappedFile file(path);
+  long long header;
+  const char *body = parse_header(file, &header, 1, path);
+  const char *end = file.data() + file.size();
+  int V = header_vertices(header, path);
+  threads = resolve_threads(threads);
+
+  std::vector<const char *> bounds = split_lines(body, end, chunk_count(end - body, threads));
+  int chunks = static_cast<int>(bounds.size()) - 1;
+  std::atomic<bool> bad(false);
+
+  // Pass 1: count the neighbors of every vertex
+  std::vector<long long> offsets(V + 1, 0);
+  std::vector<std::vector<int>> lists(threads);
+  parallel_chunks(
+      0, chunks, [&](int tid, long long lo, long long hi)
+      {
+        for (long long c = lo; c < hi; c++)
+        {
+          for_each_adjacency_line(bounds[c], bounds[c + 1], [&](long long v, const char *first, const char *last)
+                                  {
+            if (v >= V || !parse_list(first, last, V, lists[tid]))
+            {
+              bad = true;
+              return;
+            }
+
+            std::atomic_ref<long long>(offsets[v + 1]).fetch_add(lists[tid].size(), std::memory_order_relaxed); });
+        } },
+      threads, 1);
+
+  if (bad)
+  {
+    throw std::runtime_error("Malformed adjacency list or neighbor out of range in graph file " + path);
+  }
+
+  prefix_sums(offsets);
+
+  // Pass 2: copy every list to its reserved slice
+  std::vector<int> targets(offsets[V]);
+  std::vector<long long> cursor(offsets.begin(), offsets.end() - 1);
+  parallel_chunks(
+      0, chunks, [&](int tid, long long lo, long long hi)
+      {
+        std::vector<int> &list = lists[tid];
+        for (long long c = lo; c < hi; c++)
+        {
+          for_each_adjacency_line(bounds[c], bounds[c + 1], [&](long long v, const char *first, const char *last)
+                                  {
+            parse_list(first, last, V, list);
+            long long at = std::atomic_ref<long long>(cursor[v]).fetch_add(list.size(), std::memory_order_relaxed);
+            std::copy(list.begin(), list.end(), targets.begin() + at); });
+        } },
+      threads, 1);
+
+  return CSRGraph(V, std::move(offsets), std::move(targets), directed);
+}
+
+CSRGraph GraphLoader::load_edge_list(const std::string &path, bool directed, int threads)
+{
+  MappedFile file(path);
+  long long header[2];
+  const char *body = parse_header(file, header, 2, path);
+  const char *end = file.data() + file.size();
+  int V = header_vertices(header[0], path);
+  threads = resolve_threads(threads);
+
+  std::vector<const char *> bounds = split_lines(body, end, chunk_count(end - body, threads));
+  int chunks = static_cast<int>(bounds.size()) - 1;
+  std::atomic<bool> bad(false);
+
+  // Pass 1: count the arcs leaving every vertex
+  std::vector<long long> offsets(V + 1, 0);
+  parallel_chunks(
+      0, chunks, [&](int, long long lo, long long hi)
+      {
+        for (long long c = lo; c < hi; c++)
+        {
+          bool ok = for_each_pair(bounds[c], bounds[c + 1], [&](long long v, long long w)
+                                  {
+            if (v >= V || w >= V)
+            {
+              bad = true;
+              return;
+            }
+
+            std::atomic_ref<long long>(offsets[v + 1]).fetch_add(1, std::memory_order_relaxed);
+            if (!directed)
+            {
+              std::atomic_ref<long long>(offsets[w + 1]).fetch_add(1, std::memory_order_relaxed);
+            } });
+          if (!ok)
+          {
+            bad = true;
+          }
+        } },
+      threads, 1);
+
+  if (bad)
+  {
+    throw std::runtime_error("Malformed edge list in graph file " + path);
+  }
+
+  prefix_sums(offsets);
+  long long arcs = offsets[V];
+  if (arcs != (directed ? header[1] : 2 * header[1]))
+  {
+    throw std::runtime_error("Edge count in the header of " + path + " does not match its edges");
+  }
+
+  // Pass 2: scatter the arcs
+  std::vector<int> targets(arcs);
+  std::vector<long long> cursor(offsets.begin(), offsets.end() - 1);
+  parallel_chunks(
+      0, chunks, [&](int, long long lo, long long hi)
+      {
+        for (long long c = lo; c < hi; c++)
+        {
+          for_each_pair(bounds[c], bounds[c + 1], [&](long long v, long long w)
+                        {
+            targets[std::atomic_ref<long long>(cursor[v]).fetch_add(1, std::memory_order_relaxed)] = static_cast<int>(w);
+            if (!directed)
+            {
+              targets[std::atomic_ref<long long>(cursor[w]).fetch_add(1, std::memory_order_relaxed)] = static_cast<int>(v);
+            } });
+        } },
+      threads, 1);
+
+  return CSRGraph(V, std::move(offsets), std::move(targets), directed);
+}
+
+void GraphLoader::load(const std::string &path, BaseGraph &g, int threads)
+{
+  if (g.V() != 0)
+  {
+    throw std::runtime_error("Cannot load a file into a non-empty graph");
+  }
+
+  fill(load_adjacency(path, g.is_directed(), threads), g);
+}
+
+void GraphLoader::fill(const CSRGraph &csr, BaseGraph &g)
+{
+  if (g.V() != 0)
+  {
+    throw std::runtime_error("Cannot fill a non-empty graph");
+  }
+
+  if (csr.is_directed() != g.is_directed())
+  {
+    throw std::runtime_error("Cannot fill a graph from a CSR graph of the other kind");
+  }
+
+  g.V(csr.V());
+  for (int v = 0; v < csr.V(); v++)
+  {
+    g._adj.append(v, csr.adj(v));
+  }
+  g._E = csr.E();
+
+  Digraph *d = dynamic_cast<Digraph *>(&g);
+  if (d != nullptr)
+  {
+    std::vector<int> indegree = csr.in_degrees();
+    std::copy(indegree.begin(), indegree.end(), d->indegree);
+  }
+
+  g.adjacency_replaced();
+}
@@ -13,6 +13,7 @@
 #include <sstream>
 #include <stdexcept>
 #include "alg_graphs.h"
+#include "alg_csr.h"
 
 /******************************************************************************
  *  Class: BaseGraph
@@ -21,7 +22,7 @@
  ******************************************************************************/
 void BaseGraph::validate_vertex(int v) const
 {
-  if (v < 0 || v > _V)
+  if (v < 0 || v >= _V)
   {
     throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(_V - 1));
   }
@@ -31,24 +32,11 @@ void BaseGraph::copy_graph(const BaseGraph &g)
 {
   V(g.V());
   _E = g.E();
-
-  for (int v = 0; v < _V; v++)
-  {
-    for (int w : g.adj(v))
-    {
-      _adj[v].push_back(w);
-    }
-  }
+  _adj = g._adj; // Page by page
 }
 
 // Constructors
-BaseGraph::BaseGraph(int V) : _V(V)
-{
-  if (_V != 0)
-  {
-    _adj = new std::list<int>[V];
-  }
-}
+BaseGraph::BaseGraph(int V) : _V(V), _adj(V) {}
 
 // copy constructor and operator
 BaseGraph::BaseGraph(const BaseGraph &g) : _V(0)
@@ -60,33 +48,33 @@ BaseGraph &BaseGraph::operator=(const BaseGraph &g)
 {
   if (this != &g)
   {
-    delete[] _adj;
     _V = 0;
     copy_graph(g);
+    adjacency_replaced();
   }
 
   return *this;
 }
 
 // Move constructor and operator
-BaseGraph::BaseGraph(BaseGraph &&g) noexcept : _V(g._V), _E(g._E), _adj(g._adj)
+BaseGraph::BaseGraph(BaseGraph &&g) noexcept : _V(g._V), _E(g._E), _adj(std::move(g._adj))
 {
   g._V = 0;
   g._E = 0;
-  g._adj = nullptr;
+  g._adj = AdjacencyArena();
 }
 
 BaseGraph &BaseGraph::operator=(BaseGraph &&g) noexcept
 {
-  delete[] _adj;
   _V = g._V;
-  _E = g._E = 0;
-  _adj = g._adj;
+  _E = g._E;
+  _adj = std::move(g._adj);
 
   g._V = 0;
   g._E = 0;
-  g._adj = nullptr;
+  g._adj = AdjacencyArena();
 
+  adjacency_replaced();
   return *this;
 }
 
@@ -101,7 +89,7 @@ void BaseGraph::V(int V)
   }
 
   _V = V;
-  _adj = new std::list<int>[V];
+  _adj.reset(V);
 }
 
 int BaseGraph::E() const { return _E; }
@@ -110,12 +98,16 @@ bool BaseGraph::edge(int v, int w) const
 {
   validate_vertex(v);
   validate_vertex(w);
-  auto &list = _adj[v];
-  auto it = std::find(list.begin(), list.end(), w);
-  return it != list.end();
+  return _adj.contains(v, w);
 }
 
 std::list<int> BaseGraph::adj(int v) const
+{
+  validate_vertex(v);
+  return std::list<int>(_adj[v].begin(), _adj[v].end());
+}
+
+AdjacencyArena::Range BaseGraph::neighbors(int v) const
 {
   validate_vertex(v);
   return _adj[v];
@@ -174,7 +166,7 @@ std::istream &operator>>(std::istream &in, BaseGraph &g)
         else
         {
           g._E++;
-          g._adj[v].push_back(w);
+          g._adj.push_back(v, w);
         }
       }
     }
@@ -183,15 +175,19 @@ std::istream &operator>>(std::istream &in, BaseGraph &g)
   if (!g.is_directed())
     g._E /= 2;
 
+  g.adjacency_replaced();
+
   return in;
 }
 
-// Clean up
-BaseGraph::~BaseGraph() noexcept
+void BaseGraph::save_binary(const std::string &path) const
 {
-  delete[] _adj;
+  CSRGraph(*this).save_binary(path);
 }
 
+// Clean up
+BaseGraph::~BaseGraph() noexcept {}
+
 /******************************************************************************
  *  Class: Graph
  *  A class representing undirected graphs
@@ -207,7 +203,8 @@ bool Graph::is_directed() const { return false; }
 
 int Graph::degree(int v) const
 {
-  return this->adj(v).size();
+  validate_vertex(v);
+  return _adj.size(v);
 }
 
 // Adding/removing edges
@@ -216,21 +213,20 @@ void Graph::add_edge(int v, int w)
   validate_vertex(v);
   validate_vertex(w);
   _E++;
-  _adj[v].push_back(w);
-  _adj[w].push_back(v);
+  _adj.push_back(v, w);
+  _adj.push_back(w, v);
 }
 
 void Graph::remove_edge(int v, int w)
 {
   validate_vertex(v);
   validate_vertex(w);
-  auto &v_list = this->_adj[v];
-  auto it = std::find(v_list.begin(), v_list.end(), w);
-  v_list.erase(it);
+  if (!_adj.erase(v, w))
+  {
+    throw std::runtime_error("edge " + std::to_string(v) + "-" + std::to_string(w) + " does not exist");
+  }
 
-  auto w_list = this->_adj[w];
-  it = std::find(w_list.begin(), w_list.end(), v);
-  w_list.erase(it);
+  _adj.erase(w, v);
   this->_E--;
 }
 
@@ -315,7 +311,8 @@ int Digraph::degree(int v) const
 
 int Digraph::out_degree(int v) const
 {
-  return this->adj(v).size();
+  validate_vertex(v);
+  return _adj.size(v);
 }
 
 int Digraph::in_degree(int v) const
@@ -330,7 +327,7 @@ void Digraph::add_edge(int v, int w)
   validate_vertex(v);
   validate_vertex(w);
   _E++;
-  _adj[v].push_back(w);
+  _adj.push_back(v, w);
   indegree[w]++;
 }
 
@@ -338,9 +335,11 @@ void Digraph::remove_edge(int v, int w)
 {
   validate_vertex(v);
   validate_vertex(w);
-  auto &v_list = this->_adj[v];
-  auto it = std::find(v_list.begin(), v_list.end(), w);
-  v_list.erase(it);
+  if (!_adj.erase(v, w))
+  {
+    throw std::runtime_error("edge " + std::to_string(v) + "->" + std::to_string(w) + " does not exist");
+  }
+
   this->_E--;
   indegree[w]--;
 }
@@ -351,7 +350,7 @@ Digraph Digraph::reverse() const
   r.V(BaseGraph::V());
   for (int v = 0; v < BaseGraph::V(); v++)
   {
-    for (int w : this->adj(v))
+    for (int w : _adj[v])
     {
       r.add_edge(w, v);
     }
@@ -385,7 +384,8 @@ std::ostream &operator<<(std::ostream &out, Color &c)
   return out << "U"; // Unknown
 }
 
-DepthFirstSearch::DepthFirstSearch(BaseGraph &g) : g(g), v_attributes(new VertexAttribute[g.V()])
+DepthFirstSearch::DepthFirstSearch(BaseGraph &g) : g(g), v_attributes(new VertexAttribute[g.V()]),
+      directed(g.is_directed()), traversal(g)
 {
   for (int v = 0; v < g.V(); v++)
   {
@@ -396,7 +396,8 @@ DepthFirstSearch::DepthFirstSearch(BaseGraph &g) : g(g), v_attributes(new Vertex
   }
 }
 
-DepthFirstSearch::DepthFirstSearch(BaseGraph &g, int s) : g(g), v_attributes(new VertexAttribute[g.V()])
+DepthFirstSearch::DepthFirstSearch(BaseGraph &g, int s) : g(g), v_attributes(new VertexAttribute[g.V()]),
+      directed(g.is_directed()), traversal(g)
 {
   if (v_attributes[s].color == Color::White)
   {
@@ -404,7 +405,8 @@ DepthFirstSearch::DepthFirstSearch(BaseGraph &g, int s) : g(g), v_attributes(new
   }
 }
 
-DepthFirstSearch::DepthFirstSearch(BaseGraph &g, std::list<int> &sources) : g(g), v_attributes(new VertexAttribute[g.V()])
+DepthFirstSearch::DepthFirstSearch(BaseGraph &g, std::list<int> &sources) : g(g), v_attributes(new VertexAttribute[g.V()]),
+      directed(g.is_directed()), traversal(g)
 {
   for (int s : sources)
   {
@@ -415,33 +417,44 @@ DepthFirstSearch::DepthFirstSearch(BaseGraph &g, std::list<int> &sources) : g(g)
   }
 }
 
-void DepthFirstSearch::dfs(int u)
+struct DepthFirstSearch::Recorder
 {
-  time++;
+  DepthFirstSearch &search;
 
-  v_attributes[u].time[0] = time;
-  v_attributes[u].color = Color::Grey;
-  if (g.is_directed())
-    pre.push_back(u);
-  for (int v : g.adj(u))
+  void discover(int v)
   {
-    if (v_attributes[v].color == Color::White)
-    {
-      v_attributes[v].parent = u;
-      dfs(v);
-    }
+    VertexAttribute &a = search.v_attributes[v];
+    a.time[0] = ++search.time;
+    a.color = Color::Grey;
+    if (search.directed)
+      search.pre.push_back(v);
   }
-  if (g.is_directed())
-    post.push_back(u);
-  v_attributes[u].color = Color::Black;
-  v_attributes[u].component = c_count;
-  if (v_attributes[u].parent == -1)
+
+  void tree_edge(int v, int w)
   {
-    c_count++;
+    search.v_attributes[w].parent = v;
   }
 
-  time++;
-  v_attributes[u].time[1] = time;
+  void finish(int v)
+  {
+    VertexAttribute &a = search.v_attributes[v];
+    if (search.directed)
+      search.post.push_back(v);
+    a.color = Color::Black;
+    a.component = search.c_count;
+    if (a.parent == -1)
+    {
+      search.c_count++;
+    }
+    a.time[1] = ++search.time;
+  }
+};
+
+// Iterative, so the depth of the graph does not grow the call stack
+void DepthFirstSearch::dfs(int u)
+{
+  Recorder recorder{*this};
+  traversal.run(u, recorder);
 }
 
 std::stack<int> DepthFirstSearch::path_to(int v)
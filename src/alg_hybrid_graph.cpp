@@ -0,0 +1,245 @@
+/******************************************************************************
+ *  File: alg_hybrid_graph.cpp
+ *
+ *  An implementation file of the hybrid adjacency graph.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include "alg_hybrid_graph.h"
+
+/******************************************************************************
+ *  Class: HybridGraph
+ *  A simple graph with small-vector / hash-set / bitmap adjacency.
+ ******************************************************************************/
+void HybridGraph::validate_vertex(int v) const
+{
+  if (v < 0 || v >= _V)
+  {
+    throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(_V - 1));
+  }
+}
+
+bool HybridGraph::has_arc(int v, int w) const
+{
+  if (_mode == AdjacencyMode::DenseBitmap)
+  {
+    return (matrix[v * row_words + w / 64] >> (w % 64)) & 1;
+  }
+
+  const Neighbors &n = lists[v];
+  if (n.hub != nullptr)
+  {
+    return n.hub->contains(w);
+  }
+
+  return std::find(n.small.begin(), n.small.end(), w) != n.small.end();
+}
+
+bool HybridGraph::add_arc(int v, int w)
+{
+  if (_mode == AdjacencyMode::DenseBitmap)
+  {
+    std::uint64_t &word = matrix[v * row_words + w / 64];
+    std::uint64_t bit = std::uint64_t(1) << (w % 64);
+    if (word & bit)
+    {
+      return false;
+    }
+
+    word |= bit;
+    degrees[v]++;
+    return true;
+  }
+
+  Neighbors &n = lists[v];
+  if (n.hub != nullptr)
+  {
+    return n.hub->insert(w);
+  }
+
+  if (std::find(n.small.begin(), n.small.end(), w) != n.small.end())
+  {
+    return false;
+  }
+
+  n.small.push_back(w);
+  if (static_cast<int>(n.small.size()) > hub_threshold)
+  {
+    n.hub = std::make_unique<FlatHashSet<int>>();
+    for (int x : n.small)
+    {
+      n.hub->insert(x);
+    }
+    std::vector<int>().swap(n.small);
+  }
+
+  return true;
+}
+
+bool HybridGraph::remove_arc(int v, int w)
+{
+  if (_mode == AdjacencyMode::DenseBitmap)
+  {
+    std::uint64_t &word = matrix[v * row_words + w / 64];
+    std::uint64_t bit = std::uint64_t(1) << (w % 64);
+    if (!(word & bit))
+    {
+      return false;
+    }
+
+    word &= ~bit;
+    degrees[v]--;
+    return true;
+  }
+
+  Neighbors &n = lists[v];
+  if (n.hub != nullptr)
+  {
+    if (!n.hub->erase(w))
+    {
+      return false;
+    }
+
+    // Demote well below the threshold so a hub hovering around it does not
+    // flip back and forth
+    if (static_cast<int>(n.hub->size()) < hub_threshold / 4)
+    {
+      n.hub->for_each([&n](int x)
+                      { n.small.push_back(x); });
+      n.hub.reset();
+    }
+
+    return true;
+  }
+
+  auto it = std::find(n.small.begin(), n.small.end(), w);
+  if (it == n.small.end())
+  {
+    return false;
+  }
+
+  *it = n.small.back(); // Order is not kept, so swap with the last
+  n.small.pop_back();
+  return true;
+}
+
+// Constructors
+HybridGraph::HybridGraph(int V, bool directed, AdjacencyMode mode, int hub_threshold)
+    : _V(V), _directed(directed), _mode(V <= MAX_DENSE_VERTICES ? mode : AdjacencyMode::Hybrid),
+      hub_threshold(std::max(hub_threshold, 1))
+{
+  if (_mode == AdjacencyMode::DenseBitmap)
+  {
+    row_words = (V + 63) / 64;
+    matrix.assign(static_cast<long long>(V) * row_words, 0);
+    degrees.assign(V, 0);
+  }
+  else
+  {
+    lists.resize(V);
+  }
+}
+
+HybridGraph::HybridGraph(const CSRGraph &g, AdjacencyMode mode, int hub_threshold)
+    : HybridGraph(g.V(), g.is_directed(), mode, hub_threshold)
+{
+  for (int v = 0; v < _V; v++)
+  {
+    if (_mode == AdjacencyMode::Hybrid && g.degree(v) <= this->hub_threshold)
+    {
+      lists[v].small.reserve(g.degree(v));
+    }
+
+    for (int w : g.adj(v))
+    {
+      // Undirected CSR graphs already list both directions of every edge
+      if (add_arc(v, w) && (_directed || v <= w))
+      {
+        _E++;
+      }
+    }
+  }
+}
+
+// Vertices and edges
+int HybridGraph::V() const { return _V; }
+
+long long HybridGraph::E() const { return _E; }
+
+bool HybridGraph::is_directed() const { return _directed; }
+
+AdjacencyMode HybridGraph::mode() const { return _mode; }
+
+bool HybridGraph::is_hub(int v) const
+{
+  validate_vertex(v);
+  return _mode == AdjacencyMode::Hybrid && lists[v].hub != nullptr;
+}
+
+bool HybridGraph::edge(int v, int w) const
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  return has_arc(v, w);
+}
+
+std::vector<int> HybridGraph::adj(int v) const
+{
+  validate_vertex(v);
+  std::vector<int> list;
+  list.reserve(degree(v));
+  for_each_adj(v, [&list](int w)
+               { list.push_back(w); });
+  return list;
+}
+
+// Degrees
+int HybridGraph::degree(int v) const
+{
+  validate_vertex(v);
+  if (_mode == AdjacencyMode::DenseBitmap)
+  {
+    return degrees[v];
+  }
+
+  const Neighbors &n = lists[v];
+  return n.hub != nullptr ? static_cast<int>(n.hub->size()) : static_cast<int>(n.small.size());
+}
+
+// Adding/removing edges
+bool HybridGraph::add_edge(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  if (!add_arc(v, w))
+  {
+    return false;
+  }
+
+  if (!_directed && v != w)
+  {
+    add_arc(w, v);
+  }
+
+  _E++;
+  return true;
+}
+
+bool HybridGraph::remove_edge(int v, int w)
+{
+  validate_vertex(v);
+  validate_vertex(w);
+  if (!remove_arc(v, w))
+  {
+    return false;
+  }
+
+  if (!_directed && v != w)
+  {
+    remove_arc(w, v);
+  }
+
+  _E--;
+  return true;
+}
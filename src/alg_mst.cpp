@@ -0,0 +1,232 @@
+/******************************************************************************
+ *  File: alg_mst.cpp
+ *
+ *  An implementation file of the minimum spanning forest classes.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+#include "alg_mst.h"
+#include "alg_parallel.h"
+#include "alg_uf.h"
+
+/******************************************************************************
+ *  Function: radix_sort_by_weight
+ *  Stable LSD radix sort of edges by weight, 8 bits per pass. Every thread
+ *  owns a contiguous block: it counts the digits of its block, and after a
+ *  prefix sum over (digit, thread) scatters the block to its own slots, which
+ *  keeps every pass stable.
+ ******************************************************************************/
+static void radix_sort_by_weight(std::vector<WeightedEdge> &edges, long long max_weight, int threads)
+{
+  const int RADIX = 256;
+  long long n = edges.size();
+  threads = static_cast<int>(std::min<long long>(resolve_threads(threads), std::max(1LL, n / 65536)));
+  long long block = (n + threads - 1) / threads;
+
+  std::vector<WeightedEdge> buffer(n);
+  std::vector<long long> count(static_cast<long long>(threads) * RADIX);
+  int passes = (std::bit_width(static_cast<unsigned long long>(max_weight)) + 7) / 8;
+  for (int pass = 0; pass < passes; pass++)
+  {
+    int shift = 8 * pass;
+    auto digit = [shift](const WeightedEdge &e)
+    { return static_cast<int>((e.weight >> shift) & (RADIX - 1)); };
+
+    std::fill(count.begin(), count.end(), 0);
+    parallel_run(threads, [&](int tid)
+                 {
+      long long *local = count.data() + tid * RADIX;
+      for (long long i = tid * block; i < std::min(n, (tid + 1) * block); i++)
+      {
+        local[digit(edges[i])]++;
+      } });
+
+    long long sum = 0;
+    for (int d = 0; d < RADIX; d++)
+    {
+      for (int t = 0; t < threads; t++)
+      {
+        long long c = count[t * RADIX + d];
+        count[t * RADIX + d] = sum;
+        sum += c;
+      }
+    }
+
+    parallel_run(threads, [&](int tid)
+                 {
+      long long *cursor = count.data() + tid * RADIX;
+      for (long long i = tid * block; i < std::min(n, (tid + 1) * block); i++)
+      {
+        buffer[cursor[digit(edges[i])]++] = edges[i];
+      } });
+
+    edges.swap(buffer);
+  }
+}
+
+/******************************************************************************
+ *  Class: MinimumSpanningForest
+ *  A base class holding the forest.
+ ******************************************************************************/
+MinimumSpanningForest::MinimumSpanningForest(const EdgeWeightedGraph &g)
+{
+  if (g.is_directed())
+  {
+    throw std::runtime_error("Minimum spanning forests need an undirected graph");
+  }
+}
+
+void MinimumSpanningForest::add(const WeightedEdge &e)
+{
+  _edges.push_back(e);
+  _weight += e.weight;
+}
+
+long long MinimumSpanningForest::weight() const { return _weight; }
+
+const std::vector<WeightedEdge> &MinimumSpanningForest::edges() const { return _edges; }
+
+MinimumSpanningForest::~MinimumSpanningForest() noexcept {}
+
+/******************************************************************************
+ *  Class: KruskalMST
+ *  Kruskal's algorithm over radix-sorted edges.
+ ******************************************************************************/
+KruskalMST::KruskalMST(const EdgeWeightedGraph &g, int threads) : MinimumSpanningForest(g)
+{
+  std::vector<WeightedEdge> sorted = g.edges();
+  radix_sort_by_weight(sorted, g.max_weight(), threads);
+
+  PCWQuickUF uf(g.V());
+  for (const WeightedEdge &e : sorted)
+  {
+    if (uf._union(e.v, e.w))
+    {
+      add(e);
+      if (uf.components_count() == 1)
+      {
+        break;
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ *  Class: BoruvkaMST
+ *  A parallel Boruvka algorithm with edge filtering.
+ ******************************************************************************/
+BoruvkaMST::BoruvkaMST(const EdgeWeightedGraph &g, int threads) : MinimumSpanningForest(g)
+{
+  threads = resolve_threads(threads);
+  const std::vector<WeightedEdge> all = g.edges();
+  auto lighter = [&all](int a, int b)
+  {
+    return all[a].weight < all[b].weight || (all[a].weight == all[b].weight && a < b);
+  };
+
+  std::vector<int> live; // Indices of the edges between different components
+  for (int i = 0; i < static_cast<int>(all.size()); i++)
+  {
+    if (all[i].v != all[i].w)
+    {
+      live.push_back(i);
+    }
+  }
+
+  ConcurrentUF uf(g.V());
+  std::vector<int> comp(g.V()), best(g.V(), -1);
+  for (int v = 0; v < g.V(); v++)
+  {
+    comp[v] = v;
+  }
+
+  std::vector<std::vector<int>> kept(threads), picked(threads);
+  std::vector<int> added;
+  while (!live.empty())
+  {
+    _rounds++;
+
+    // Lightest outgoing edge of every component
+    parallel_for(
+        0, live.size(), [&](long long i)
+        {
+          int e = live[i];
+          for (int c : {comp[all[e].v], comp[all[e].w]})
+          {
+            std::atomic_ref<int> slot(best[c]);
+            int old = slot.load(std::memory_order_relaxed);
+            while ((old == -1 || lighter(e, old)) && !slot.compare_exchange_weak(old, e, std::memory_order_relaxed))
+            {
+            }
+          } },
+        threads, 4096);
+
+    // The picked edges form a forest (ties are broken by index), so every
+    // union succeeds. Two components may pick the same edge; the lower one
+    // takes it.
+    parallel_chunks(
+        0, g.V(), [&](int tid, long long lo, long long hi)
+        {
+          for (long long c = lo; c < hi; c++)
+          {
+            int e = best[c];
+            if (e == -1)
+            {
+              continue;
+            }
+
+            int other = comp[all[e].v] == c ? comp[all[e].w] : comp[all[e].v];
+            if (other > c || best[other] != e)
+            {
+              uf._union(all[e].v, all[e].w);
+              picked[tid].push_back(e);
+            }
+          } },
+        threads, 4096);
+
+    // Only the forest edges of this round are serial; sorting them keeps
+    // the output the same whatever thread picked them
+    added.clear();
+    for (std::vector<int> &local : picked)
+    {
+      added.insert(added.end(), local.begin(), local.end());
+      local.clear();
+    }
+    std::sort(added.begin(), added.end());
+    for (int e : added)
+    {
+      add(all[e]);
+    }
+
+    parallel_for(0, g.V(), [&](long long v)
+                 {
+      best[v] = -1;
+      comp[v] = uf._find(v); }, threads, 4096);
+
+    // Drop the edges that became internal
+    parallel_chunks(
+        0, live.size(), [&](int tid, long long lo, long long hi)
+        {
+          for (long long i = lo; i < hi; i++)
+          {
+            const WeightedEdge &e = all[live[i]];
+            if (comp[e.v] != comp[e.w])
+            {
+              kept[tid].push_back(live[i]);
+            }
+          } },
+        threads, 4096);
+
+    live.clear();
+    for (std::vector<int> &local : kept)
+    {
+      live.insert(live.end(), local.begin(), local.end());
+      local.clear();
+    }
+  }
+}
+
+int BoruvkaMST::rounds() const { return _rounds; }
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *  File: alg_pagerank.cpp
+ *
+ *  An implementation file of the pull-based PageRank engine.
+ ******************************************************************************/
+
+#include <cmath>
+#include <stdexcept>
+#include "alg_pagerank.h"
+#include "alg_parallel.h"
+
+/******************************************************************************
+ *  Class: PageRank
+ *  Pull-based (personalized) PageRank.
+ ******************************************************************************/
+template <class Real>
+PageRank<Real>::PageRank(const Digraph &g, const PageRankOptions &options)
+    : in_edges(g.reverse()), out_degree(g.V()), options(options)
+{
+  for (int v = 0; v < g.V(); v++)
+  {
+    out_degree[v] = g.out_degree(v);
+  }
+
+  run();
+}
+
+template <class Real>
+PageRank<Real>::PageRank(const CSRGraph &g, const PageRankOptions &options)
+    : in_edges(g.transpose()), out_degree(g.V()), options(options)
+{
+  for (int v = 0; v < g.V(); v++)
+  {
+    out_degree[v] = g.degree(v);
+  }
+
+  run();
+}
+
+template <class Real>
+void PageRank<Real>::run(const std::vector<double> &personalization)
+{
+  const int V = in_edges.V();
+  const int threads = resolve_threads(options.threads);
+  if (V == 0)
+  {
+    _ranks.clear();
+    _iterations = 0;
+    _residual = 0;
+    return;
+  }
+
+  // Normalized teleport distribution
+  std::vector<Real> teleport(V, Real(1.0 / V));
+  if (!personalization.empty())
+  {
+    if (static_cast<int>(personalization.size()) != V)
+    {
+      throw std::runtime_error("Personalization vector size does not match the number of vertices");
+    }
+
+    double total = 0;
+    for (double p : personalization)
+    {
+      if (p < 0)
+      {
+        throw std::runtime_error("Personalization weights must not be negative");
+      }
+      total += p;
+    }
+
+    if (total <= 0)
+    {
+      throw std::runtime_error("Personalization weights must not all be zero");
+    }
+
+    for (int v = 0; v < V; v++)
+    {
+      teleport[v] = Real(personalization[v] / total);
+    }
+  }
+
+  const Real damping = Real(options.damping);
+  std::vector<Real> contribution(V), next(V);
+  std::vector<double> dangling(threads), change(threads);
+  _ranks = teleport;
+  _residual = 0;
+  for (_iterations = 0; _iterations < options.max_iterations;)
+  {
+    std::fill(dangling.begin(), dangling.end(), 0.0);
+    parallel_chunks(
+        0, V, [&](int tid, long long lo, long long hi)
+        {
+          for (long long u = lo; u < hi; u++)
+          {
+            if (out_degree[u] == 0)
+            {
+              dangling[tid] += _ranks[u];
+              contribution[u] = 0;
+            }
+            else
+            {
+              contribution[u] = _ranks[u] / out_degree[u];
+            }
+          } },
+        threads, 4096);
+
+    double dangling_mass = 0;
+    for (double d : dangling)
+    {
+      dangling_mass += d;
+    }
+
+    // Everything not following an edge teleports
+    const Real jump = Real(1 - options.damping + options.damping * dangling_mass);
+    std::fill(change.begin(), change.end(), 0.0);
+    parallel_chunks(
+        0, V, [&](int tid, long long lo, long long hi)
+        {
+          double local = 0;
+          for (long long v = lo; v < hi; v++)
+          {
+            Real sum = 0;
+            for (int u : in_edges.adj(static_cast<int>(v)))
+            {
+              sum += contribution[u];
+            }
+
+            next[v] = damping * sum + jump * teleport[v];
+            local += std::abs(static_cast<double>(next[v]) - _ranks[v]);
+          }
+          change[tid] += local; },
+        threads, 1024);
+
+    _ranks.swap(next);
+    _iterations++;
+    _residual = 0;
+    for (double c : change)
+    {
+      _residual += c;
+    }
+
+    if (_residual < options.tolerance)
+    {
+      break;
+    }
+  }
+}
+
+template <class Real>
+const std::vector<Real> &PageRank<Real>::ranks() const { return _ranks; }
+
+template <class Real>
+Real PageRank<Real>::rank(int v) const { return _ranks[v]; }
+
+template <class Real>
+int PageRank<Real>::iterations() const { return _iterations; }
+
+template <class Real>
+double PageRank<Real>::residual() const { return _residual; }
+
+template <class Real>
+bool PageRank<Real>::converged() const { return _residual < options.tolerance; }
+
+template class PageRank<float>;
+template class PageRank<double>;
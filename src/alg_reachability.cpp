@@ -0,0 +1,304 @@
+/******************************************************************************
+ *  File: alg_reachability.cpp
+ *
+ *  An implementation file of the batched reachability tools.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include "alg_parallel.h"
+#include "alg_reachability.h"
+#include "alg_scc.h"
+
+/******************************************************************************
+ *  Class: MultiSourceBFS
+ *  A bit-parallel multi-source breadth-first search.
+ ******************************************************************************/
+MultiSourceBFS::MultiSourceBFS(const CSRGraph &g, const std::vector<int> &sources, int threads)
+    : _V(g.V()), _sources(sources), threads(resolve_threads(threads))
+{
+  for (int s : _sources)
+  {
+    if (s < 0 || s >= g.V())
+    {
+      throw std::runtime_error("vertex " + std::to_string(s) + " is not between 0 and " + std::to_string(g.V() - 1));
+    }
+  }
+
+  long long total_words = 0;
+  for (int first = 0; first < sources_count(); first += BATCH)
+  {
+    int count = std::min(BATCH, sources_count() - first);
+    total_words += static_cast<long long>(g.V()) * ((count + 63) / 64);
+  }
+  seen.assign(total_words, 0);
+
+  // Narrow batches use narrow bitsets, so a handful of sources costs one word
+  std::uint64_t *out = seen.data();
+  for (int first = 0; first < sources_count(); first += BATCH)
+  {
+    int count = std::min(BATCH, sources_count() - first);
+    switch ((count + 63) / 64)
+    {
+    case 1:
+      run_batch<1>(g, first, count, out);
+      break;
+    case 2:
+      run_batch<2>(g, first, count, out);
+      break;
+    case 3:
+      run_batch<3>(g, first, count, out);
+      break;
+    default:
+      run_batch<4>(g, first, count, out);
+      break;
+    }
+
+    out += static_cast<long long>(g.V()) * ((count + 63) / 64);
+  }
+}
+
+template <int W>
+void MultiSourceBFS::run_batch(const CSRGraph &g, int first, int count, std::uint64_t *out)
+{
+  int V = g.V();
+  std::uint64_t *visit_seen = out; // The result doubles as the seen set
+  std::vector<std::uint64_t> visit(static_cast<long long>(V) * W, 0), next(static_cast<long long>(V) * W, 0);
+
+  for (int i = 0; i < count; i++)
+  {
+    int s = _sources[first + i];
+    visit[static_cast<long long>(s) * W + i / 64] |= std::uint64_t(1) << (i % 64);
+    visit_seen[static_cast<long long>(s) * W + i / 64] |= std::uint64_t(1) << (i % 64);
+  }
+
+  for (;;)
+  {
+    // Push the frontier bits of every active vertex to its neighbors
+    parallel_chunks(
+        0, V, [&](int, long long lo, long long hi)
+        {
+          for (long long v = lo; v < hi; v++)
+          {
+            const std::uint64_t *bits = &visit[v * W];
+            bool active = false;
+            for (int k = 0; k < W; k++)
+            {
+              active |= bits[k] != 0;
+            }
+
+            if (!active)
+            {
+              continue;
+            }
+
+            for (int w : g.adj(v))
+            {
+              for (int k = 0; k < W; k++)
+              {
+                if (bits[k] != 0)
+                {
+                  std::atomic_ref<std::uint64_t>(next[static_cast<long long>(w) * W + k]).fetch_or(bits[k], std::memory_order_relaxed);
+                }
+              }
+            }
+          } },
+        threads, 4096);
+
+    // Keep only the bits that are new, and make them the next frontier
+    std::atomic<bool> changed(false);
+    parallel_chunks(
+        0, static_cast<long long>(V) * W, [&](int, long long lo, long long hi)
+        {
+          bool any = false;
+          for (long long i = lo; i < hi; i++)
+          {
+            std::uint64_t fresh = next[i] & ~visit_seen[i];
+            visit_seen[i] |= fresh;
+            visit[i] = fresh;
+            next[i] = 0;
+            any |= fresh != 0;
+          }
+
+          if (any)
+          {
+            changed.store(true, std::memory_order_relaxed);
+          } },
+        threads, 1 << 14);
+
+    if (!changed)
+    {
+      return;
+    }
+  }
+}
+
+int MultiSourceBFS::sources_count() const
+{
+  return static_cast<int>(_sources.size());
+}
+
+bool MultiSourceBFS::reachable(int i, int v) const
+{
+  if (i < 0 || i >= sources_count())
+  {
+    throw std::runtime_error("source index " + std::to_string(i) + " is not between 0 and " +
+                             std::to_string(sources_count() - 1));
+  }
+
+  if (v < 0 || v >= _V)
+  {
+    throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(_V - 1));
+  }
+
+  int batch = i / BATCH;
+  int count = std::min(BATCH, sources_count() - batch * BATCH);
+  int words = (count + 63) / 64;
+  int bit = i % BATCH;
+  long long at = static_cast<long long>(_V) * (BATCH / 64) * batch + static_cast<long long>(v) * words + bit / 64;
+  return (seen[at] >> (bit % 64)) & 1;
+}
+
+/******************************************************************************
+ *  Class: ReachabilityIndex
+ *  A pruned 2-hop reachability labeling over the SCC condensation.
+ ******************************************************************************/
+bool ReachabilityIndex::intersect(const int *a, const int *a_end, const int *b, const int *b_end)
+{
+  while (a < a_end && b < b_end)
+  {
+    if (*a == *b)
+    {
+      return true;
+    }
+
+    if (*a < *b)
+    {
+      a++;
+    }
+    else
+    {
+      b++;
+    }
+  }
+
+  return false;
+}
+
+ReachabilityIndex::ReachabilityIndex(const CSRGraph &g)
+{
+  TarjanSCC scc(g);
+  component = scc.ids();
+  CSRGraph dag = scc.condensation(g);
+  CSRGraph reverse = dag.transpose();
+  int C = dag.V();
+
+  std::vector<int> order(C);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                   { return dag.degree(a) + reverse.degree(a) > dag.degree(b) + reverse.degree(b); });
+
+  std::vector<std::vector<int>> out(C), in(C);
+  std::vector<int> visited(C, -1), queue;
+  auto covered = [](const std::vector<int> &a, const std::vector<int> &b)
+  {
+    return intersect(a.data(), a.data() + a.size(), b.data(), b.data() + b.size());
+  };
+
+  for (int rank = 0; rank < C; rank++)
+  {
+    int c = order[rank];
+
+    // Forward: c reaches u, unless an earlier landmark already proves it
+    queue.assign(1, c);
+    visited[c] = 2 * rank;
+    for (std::size_t head = 0; head < queue.size(); head++)
+    {
+      int u = queue[head];
+      if (u != c && covered(out[c], in[u]))
+      {
+        continue;
+      }
+
+      in[u].push_back(rank);
+      for (int x : dag.adj(u))
+      {
+        if (visited[x] != 2 * rank)
+        {
+          visited[x] = 2 * rank;
+          queue.push_back(x);
+        }
+      }
+    }
+
+    // Backward: u reaches c
+    queue.assign(1, c);
+    visited[c] = 2 * rank + 1;
+    for (std::size_t head = 0; head < queue.size(); head++)
+    {
+      int u = queue[head];
+      if (u != c && covered(out[u], in[c]))
+      {
+        continue;
+      }
+
+      out[u].push_back(rank);
+      for (int x : reverse.adj(u))
+      {
+        if (visited[x] != 2 * rank + 1)
+        {
+          visited[x] = 2 * rank + 1;
+          queue.push_back(x);
+        }
+      }
+    }
+  }
+
+  // Flatten the labels; ranks were appended in increasing order
+  auto flatten = [C](std::vector<std::vector<int>> &labels, std::vector<long long> &offsets, std::vector<int> &data)
+  {
+    offsets.assign(C + 1, 0);
+    for (int c = 0; c < C; c++)
+    {
+      offsets[c + 1] = offsets[c] + labels[c].size();
+    }
+
+    data.reserve(offsets[C]);
+    for (std::vector<int> &label : labels)
+    {
+      data.insert(data.end(), label.begin(), label.end());
+      std::vector<int>().swap(label);
+    }
+  };
+
+  flatten(out, out_offsets, out_labels);
+  flatten(in, in_offsets, in_labels);
+}
+
+bool ReachabilityIndex::reachable(int s, int t) const
+{
+  const int V = static_cast<int>(component.size());
+  for (int v : {s, t})
+  {
+    if (v < 0 || v >= V)
+    {
+      throw std::runtime_error("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(V - 1));
+    }
+  }
+
+  int cs = component[s], ct = component[t];
+  if (cs == ct)
+  {
+    return true;
+  }
+
+  return intersect(out_labels.data() + out_offsets[cs], out_labels.data() + out_offsets[cs + 1],
+                   in_labels.data() + in_offsets[ct], in_labels.data() + in_offsets[ct + 1]);
+}
+
+long long ReachabilityIndex::label_entries() const
+{
+  return static_cast<long long>(out_labels.size() + in_labels.size());
+}
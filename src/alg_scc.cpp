@@ -0,0 +1,424 @@
+/******************************************************************************
+ *  File: alg_scc.cpp
+ *
+ *  An implementation file of the strongly connected component classes.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "alg_parallel.h"
+#include "alg_scc.h"
+
+/******************************************************************************
+ *  Function: tarjan
+ *  Runs Tarjan's algorithm, with an explicit call stack, over the vertices
+ *  whose id is still -1. Edges into vertices that already own an id are
+ *  ignored. New components are numbered from next_id; the next free id is
+ *  returned.
+ ******************************************************************************/
+static int tarjan(const CSRGraph &g, std::vector<int> &id, int next_id)
+{
+  struct Frame
+  {
+    int v;
+    long long next; // Position of the next edge of v to look at
+  };
+
+  std::span<const long long> offsets = g.offsets();
+  std::span<const int> targets = g.targets();
+  std::vector<int> index(g.V(), -1), low(g.V(), 0);
+  std::vector<int> stack;
+  std::vector<Frame> calls;
+  int counter = 0;
+
+  for (int r = 0; r < g.V(); r++)
+  {
+    if (id[r] != -1 || index[r] != -1)
+    {
+      continue;
+    }
+
+    index[r] = low[r] = counter++;
+    stack.push_back(r);
+    calls.push_back({r, offsets[r]});
+    while (!calls.empty())
+    {
+      Frame &f = calls.back();
+      int v = f.v;
+      if (f.next < offsets[v + 1])
+      {
+        int w = targets[f.next++];
+        if (index[w] == -1)
+        {
+          if (id[w] == -1)
+          {
+            index[w] = low[w] = counter++;
+            stack.push_back(w);
+            calls.push_back({w, offsets[w]});
+          }
+        }
+        else if (id[w] == -1) // w is still on the stack
+        {
+          low[v] = std::min(low[v], index[w]);
+        }
+
+        continue;
+      }
+
+      calls.pop_back();
+      if (low[v] == index[v])
+      {
+        int w;
+        do
+        {
+          w = stack.back();
+          stack.pop_back();
+          id[w] = next_id;
+        } while (w != v);
+        next_id++;
+      }
+
+      if (!calls.empty())
+      {
+        int u = calls.back().v;
+        low[u] = std::min(low[u], low[v]);
+      }
+    }
+  }
+
+  return next_id;
+}
+
+/******************************************************************************
+ *  Class: StronglyConnectedComponents
+ *  A base class holding a component id per vertex.
+ ******************************************************************************/
+StronglyConnectedComponents::StronglyConnectedComponents(const CSRGraph &g) : _id(g.V(), -1) {}
+
+int StronglyConnectedComponents::count() const { return _count; }
+
+int StronglyConnectedComponents::id(int v) const { return _id[v]; }
+
+const std::vector<int> &StronglyConnectedComponents::ids() const { return _id; }
+
+bool StronglyConnectedComponents::strongly_connected(int v, int w) const
+{
+  return _id[v] == _id[w];
+}
+
+CSRGraph StronglyConnectedComponents::condensation(const CSRGraph &g) const
+{
+  if (g.V() != static_cast<int>(_id.size()))
+  {
+    throw std::runtime_error("Graph has " + std::to_string(g.V()) + " vertices, the components cover " +
+                             std::to_string(_id.size()));
+  }
+
+  // Bucket the cross-component edges by source component
+  std::vector<long long> offsets(_count + 1, 0);
+  for (int v = 0; v < g.V(); v++)
+  {
+    for (int w : g.adj(v))
+    {
+      if (_id[v] != _id[w])
+      {
+        offsets[_id[v] + 1]++;
+      }
+    }
+  }
+
+  for (int c = 0; c < _count; c++)
+  {
+    offsets[c + 1] += offsets[c];
+  }
+
+  std::vector<int> targets(offsets[_count]);
+  std::vector<long long> cursor(offsets.begin(), offsets.end() - 1);
+  for (int v = 0; v < g.V(); v++)
+  {
+    for (int w : g.adj(v))
+    {
+      if (_id[v] != _id[w])
+      {
+        targets[cursor[_id[v]]++] = _id[w];
+      }
+    }
+  }
+
+  // Drop parallel edges between the same pair of components
+  parallel_for(0, _count, [&](long long c)
+               {
+    auto first = targets.begin() + offsets[c];
+    auto last = targets.begin() + offsets[c + 1];
+    std::sort(first, last);
+    cursor[c] = offsets[c] + (std::unique(first, last) - first); });
+
+  long long size = 0;
+  for (int c = 0; c < _count; c++)
+  {
+    long long begin = offsets[c];
+    offsets[c] = size;
+    for (long long i = begin; i < cursor[c]; i++)
+    {
+      targets[size++] = targets[i];
+    }
+  }
+  offsets[_count] = size;
+  targets.resize(size);
+
+  return CSRGraph(_count, std::move(offsets), std::move(targets), true);
+}
+
+StronglyConnectedComponents::~StronglyConnectedComponents() noexcept {}
+
+/******************************************************************************
+ *  Class: TarjanSCC
+ *  An iterative implementation of Tarjan's algorithm.
+ ******************************************************************************/
+TarjanSCC::TarjanSCC(const CSRGraph &g) : StronglyConnectedComponents(g)
+{
+  _count = tarjan(g, _id, 0);
+}
+
+/******************************************************************************
+ *  Class: ParallelSCC
+ *  A multi-threaded SCC finder (trim, forward-backward, coloring).
+ ******************************************************************************/
+ParallelSCC::ParallelSCC(const CSRGraph &g, int threads)
+    : StronglyConnectedComponents(g), threads(resolve_threads(threads))
+{
+  const CSRGraph gt = g.transpose();
+  std::vector<int> active(g.V());
+  std::iota(active.begin(), active.end(), 0);
+
+  trim(g, gt, active);
+  if (active.size() > SERIAL_CUTOFF)
+  {
+    forward_backward(g, gt, active);
+  }
+
+  while (active.size() > SERIAL_CUTOFF)
+  {
+    if (trim(g, gt, active) > 0 && active.size() <= SERIAL_CUTOFF)
+    {
+      break;
+    }
+
+    color_propagation(g, gt, active);
+  }
+
+  _count = tarjan(g, _id, _count);
+}
+
+// Gives every active vertex without an active in- or out-neighbor its own
+// component, repeating while that keeps peeling off a sizable share of the
+// active vertices. Returns the number of vertices removed.
+long long ParallelSCC::trim(const CSRGraph &g, const CSRGraph &gt, std::vector<int> &active)
+{
+  auto has_live_neighbor = [this](const CSRGraph &h, int v)
+  {
+    for (int w : h.adj(v))
+    {
+      if (w != v && std::atomic_ref<int>(_id[w]).load(std::memory_order_relaxed) == -1)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  };
+
+  long long removed = 0;
+  for (;;)
+  {
+    long long before = active.size();
+    parallel_for(0, before, [&](long long i)
+                 {
+      int v = active[i];
+      if (!has_live_neighbor(g, v) || !has_live_neighbor(gt, v))
+      {
+        int c = std::atomic_ref<int>(_count).fetch_add(1, std::memory_order_relaxed);
+        std::atomic_ref<int>(_id[v]).store(c, std::memory_order_relaxed);
+      } }, threads);
+
+    compact(active);
+    long long peeled = before - static_cast<long long>(active.size());
+    removed += peeled;
+    if (peeled == 0 || peeled * 100 < before)
+    {
+      return removed;
+    }
+  }
+}
+
+// Finds the component of the vertex with the largest in * out degree by
+// intersecting its forward and backward reachable sets.
+void ParallelSCC::forward_backward(const CSRGraph &g, const CSRGraph &gt, std::vector<int> &active)
+{
+  int pivot = active[0];
+  long long best = -1;
+  for (int v : active)
+  {
+    long long score = static_cast<long long>(g.degree(v)) * gt.degree(v);
+    if (score > best)
+    {
+      best = score;
+      pivot = v;
+    }
+  }
+
+  std::vector<unsigned char> mark(g.V(), 0);
+  auto bfs = [&](const CSRGraph &h, unsigned char bit)
+  {
+    std::vector<int> frontier = {pivot};
+    std::vector<std::vector<int>> next(threads);
+    mark[pivot] |= bit;
+    while (!frontier.empty())
+    {
+      parallel_chunks(
+          0, frontier.size(), [&](int tid, long long lo, long long hi)
+          {
+            for (long long i = lo; i < hi; i++)
+            {
+              for (int w : h.adj(frontier[i]))
+              {
+                if (_id[w] == -1 && !(std::atomic_ref<unsigned char>(mark[w]).fetch_or(bit) & bit))
+                {
+                  next[tid].push_back(w);
+                }
+              }
+            } },
+          threads, 256);
+
+      frontier.clear();
+      for (std::vector<int> &local : next)
+      {
+        frontier.insert(frontier.end(), local.begin(), local.end());
+        local.clear();
+      }
+    }
+  };
+
+  bfs(g, 1);
+  bfs(gt, 2);
+
+  int c = _count++;
+  parallel_for(0, active.size(), [&](long long i)
+               {
+    int v = active[i];
+    if (mark[v] == 3)
+    {
+      _id[v] = c;
+    } }, threads);
+
+  compact(active);
+}
+
+// Propagates the largest vertex number forward until it settles, so every
+// vertex ends up colored by the largest vertex that reaches it. The component
+// of each color root is then the part of its color class that reaches the
+// root backwards.
+void ParallelSCC::color_propagation(const CSRGraph &g, const CSRGraph &gt, std::vector<int> &active)
+{
+  std::vector<int> color(g.V(), -1);
+  std::vector<unsigned char> queued(g.V(), 0);
+  for (int v : active)
+  {
+    color[v] = v;
+  }
+
+  std::vector<int> frontier = active;
+  std::vector<std::vector<int>> next(threads);
+  while (!frontier.empty())
+  {
+    parallel_chunks(
+        0, frontier.size(), [&](int tid, long long lo, long long hi)
+        {
+          for (long long i = lo; i < hi; i++)
+          {
+            int v = frontier[i];
+            int c = std::atomic_ref<int>(color[v]).load(std::memory_order_relaxed);
+            for (int w : g.adj(v))
+            {
+              if (_id[w] != -1)
+              {
+                continue;
+              }
+
+              std::atomic_ref<int> cw(color[w]);
+              int old = cw.load(std::memory_order_relaxed);
+              bool raised = false;
+              while (old < c && !(raised = cw.compare_exchange_weak(old, c, std::memory_order_relaxed)))
+              {
+              }
+
+              if (raised && !std::atomic_ref<unsigned char>(queued[w]).exchange(1))
+              {
+                next[tid].push_back(w);
+              }
+            }
+          } },
+        threads, 256);
+
+    frontier.clear();
+    for (std::vector<int> &local : next)
+    {
+      frontier.insert(frontier.end(), local.begin(), local.end());
+      local.clear();
+    }
+
+    for (int v : frontier)
+    {
+      queued[v] = 0;
+    }
+  }
+
+  std::vector<int> roots;
+  for (int v : active)
+  {
+    if (color[v] == v)
+    {
+      roots.push_back(v);
+    }
+  }
+
+  // Color classes are disjoint, so every root can be searched independently
+  std::vector<std::vector<int>> stacks(threads);
+  parallel_chunks(
+      0, roots.size(), [&](int tid, long long lo, long long hi)
+      {
+        std::vector<int> &stack = stacks[tid];
+        for (long long i = lo; i < hi; i++)
+        {
+          int r = roots[i];
+          int c = std::atomic_ref<int>(_count).fetch_add(1, std::memory_order_relaxed);
+          _id[r] = c;
+          stack.push_back(r);
+          while (!stack.empty())
+          {
+            int v = stack.back();
+            stack.pop_back();
+            for (int w : gt.adj(v))
+            {
+              if (color[w] == r && _id[w] == -1)
+              {
+                _id[w] = c;
+                stack.push_back(w);
+              }
+            }
+          }
+        } },
+      threads, 1);
+
+  compact(active);
+}
+
+// Drops vertices that already belong to a component.
+void ParallelSCC::compact(std::vector<int> &active) const
+{
+  std::erase_if(active, [this](int v)
+                { return _id[v] != -1; });
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+ *  File: alg_topological.cpp
+ *
+ *  An implementation file of the parallel topological sort.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include "alg_parallel.h"
+#include "alg_topological.h"
+
+/******************************************************************************
+ *  Class: TopologicalSort
+ *  A frontier-parallel implementation of Kahn's algorithm.
+ ******************************************************************************/
+TopologicalSort::TopologicalSort(const CSRGraph &g, int threads) : _V(g.V()), _level(g.V(), -1)
+{
+  threads = resolve_threads(threads);
+  std::vector<int> indegree = g.in_degrees();
+  std::vector<std::vector<int>> next(threads);
+
+  _order.reserve(g.V());
+  _wave_offsets.push_back(0);
+  parallel_chunks(
+      0, g.V(), [&](int tid, long long lo, long long hi)
+      {
+        for (long long v = lo; v < hi; v++)
+        {
+          if (indegree[v] == 0)
+          {
+            next[tid].push_back(v);
+          }
+        } },
+      threads);
+
+  for (int k = 0;; k++)
+  {
+    long long begin = _order.size();
+    for (std::vector<int> &local : next)
+    {
+      _order.insert(_order.end(), local.begin(), local.end());
+      local.clear();
+    }
+
+    if (static_cast<long long>(_order.size()) == begin)
+    {
+      break;
+    }
+
+    std::sort(_order.begin() + begin, _order.end());
+    _wave_offsets.push_back(_order.size());
+
+    // Whoever takes a counter to zero owns the vertex in the next wave
+    parallel_chunks(
+        begin, _order.size(), [&](int tid, long long lo, long long hi)
+        {
+          for (long long i = lo; i < hi; i++)
+          {
+            int v = _order[i];
+            _level[v] = k;
+            for (int w : g.adj(v))
+            {
+              if (std::atomic_ref<int>(indegree[w]).fetch_sub(1, std::memory_order_acq_rel) == 1)
+              {
+                next[tid].push_back(w);
+              }
+            }
+          } },
+        threads, 256);
+  }
+}
+
+bool TopologicalSort::is_dag() const
+{
+  return static_cast<int>(_order.size()) == _V;
+}
+
+const std::vector<int> &TopologicalSort::order() const
+{
+  return _order;
+}
+
+int TopologicalSort::levels_count() const
+{
+  return static_cast<int>(_wave_offsets.size()) - 1;
+}
+
+std::span<const int> TopologicalSort::wave(int k) const
+{
+  return std::span<const int>(_order.data() + _wave_offsets[k], _order.data() + _wave_offsets[k + 1]);
+}
+
+int TopologicalSort::level(int v) const
+{
+  return _level[v];
+}
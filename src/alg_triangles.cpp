@@ -0,0 +1,254 @@
+/******************************************************************************
+ *  File: alg_triangles.cpp
+ *
+ *  An implementation file of triangle counting.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include "alg_parallel.h"
+#include "alg_triangles.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************
+ *  Function: gallop
+ *  Calls emit(x) for every x of the short sorted array that is also in the
+ *  long one, searching for each with exponentially growing steps from the
+ *  position of the previous match: O(|small| log(|large| / |small|)).
+ ******************************************************************************/
+template <class F>
+static void gallop(std::span<const int> small, std::span<const int> large, F &&emit)
+{
+  std::size_t lo = 0;
+  for (int x : small)
+  {
+    std::size_t step = 1, hi = lo;
+    while (hi < large.size() && large[hi] < x)
+    {
+      lo = hi + 1;
+      hi += step;
+      step *= 2;
+    }
+
+    hi = std::min(hi, large.size());
+    lo = std::lower_bound(large.begin() + lo, large.begin() + hi, x) - large.begin();
+    if (lo == large.size())
+    {
+      return;
+    }
+
+    if (large[lo] == x)
+    {
+      emit(x);
+    }
+  }
+}
+
+/******************************************************************************
+ *  Function: intersect
+ *  Calls emit(x) for every x in both sorted arrays. With SSE2, four elements
+ *  of a are compared against four of b and their three rotations at once;
+ *  the block with the smaller last element is then skipped.
+ ******************************************************************************/
+template <class F>
+static void intersect(std::span<const int> a, std::span<const int> b, F &&emit)
+{
+  if (a.size() > b.size())
+  {
+    std::swap(a, b);
+  }
+
+  if (a.empty())
+  {
+    return;
+  }
+
+  if (b.size() / a.size() >= 32)
+  {
+    gallop(a, b, emit);
+    return;
+  }
+
+  std::size_t i = 0, j = 0;
+#ifdef __SSE2__
+  while (i + 4 <= a.size() && j + 4 <= b.size())
+  {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a.data() + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b.data() + j));
+    __m128i eq = _mm_cmpeq_epi32(va, vb);
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+
+    for (int mask = _mm_movemask_ps(_mm_castsi128_ps(eq)); mask != 0; mask &= mask - 1)
+    {
+      emit(a[i + __builtin_ctz(mask)]);
+    }
+
+    int a_last = a[i + 3], b_last = b[j + 3];
+    i += a_last <= b_last ? 4 : 0;
+    j += b_last <= a_last ? 4 : 0;
+  }
+#endif
+
+  while (i < a.size() && j < b.size())
+  {
+    if (a[i] < b[j])
+    {
+      i++;
+    }
+    else if (b[j] < a[i])
+    {
+      j++;
+    }
+    else
+    {
+      emit(a[i]);
+      i++;
+      j++;
+    }
+  }
+}
+
+/******************************************************************************
+ *  Class: TriangleCounting
+ *  Degree-ordered triangle counting.
+ ******************************************************************************/
+TriangleCounting::TriangleCounting(const CSRGraph &g, int threads) : _triangles(g.V(), 0), _degree(g.V(), 0)
+{
+  if (g.is_directed())
+  {
+    throw std::runtime_error("Triangle counting needs an undirected graph");
+  }
+
+  // Sorted neighbor lists without duplicates or self-loops
+  std::vector<int> clean(g.arcs());
+  std::span<const long long> offsets = g.offsets();
+  parallel_for(
+      0, g.V(), [&](long long v)
+      {
+        auto first = clean.begin() + offsets[v];
+        auto last = std::copy(g.adj(v).begin(), g.adj(v).end(), first);
+        std::sort(first, last);
+        last = std::remove(first, std::unique(first, last), static_cast<int>(v));
+        _degree[v] = static_cast<int>(last - first); },
+      threads);
+
+  // Orient every edge towards the endpoint of higher (degree, id)
+  auto higher = [this](int w, int v)
+  {
+    return _degree[w] > _degree[v] || (_degree[w] == _degree[v] && w > v);
+  };
+
+  std::vector<long long> out_offsets(g.V() + 1, 0);
+  parallel_for(
+      0, g.V(), [&](long long v)
+      {
+        int n = 0;
+        for (long long k = offsets[v]; k < offsets[v] + _degree[v]; k++)
+        {
+          n += higher(clean[k], static_cast<int>(v));
+        }
+        out_offsets[v + 1] = n; },
+      threads);
+
+  for (int v = 0; v < g.V(); v++)
+  {
+    out_offsets[v + 1] += out_offsets[v];
+  }
+
+  std::vector<int> out(out_offsets[g.V()]);
+  parallel_for(
+      0, g.V(), [&](long long v)
+      {
+        long long at = out_offsets[v];
+        for (long long k = offsets[v]; k < offsets[v] + _degree[v]; k++)
+        {
+          if (higher(clean[k], static_cast<int>(v)))
+          {
+            out[at++] = clean[k];
+          }
+        } },
+      threads);
+
+  auto out_adj = [&](int v)
+  {
+    return std::span<const int>(out.data() + out_offsets[v], out.data() + out_offsets[v + 1]);
+  };
+
+  // Every triangle is found once, from its lowest vertex v
+  std::vector<long long> partial(resolve_threads(threads), 0);
+  parallel_chunks(
+      0, g.V(), [&](int tid, long long lo, long long hi)
+      {
+        for (long long v = lo; v < hi; v++)
+        {
+          long long at_v = 0;
+          for (int w : out_adj(static_cast<int>(v)))
+          {
+            long long at_w = 0;
+            intersect(out_adj(static_cast<int>(v)), out_adj(w), [&](int x)
+                      {
+              at_w++;
+              std::atomic_ref<long long>(_triangles[x]).fetch_add(1, std::memory_order_relaxed); });
+
+            if (at_w > 0)
+            {
+              std::atomic_ref<long long>(_triangles[w]).fetch_add(at_w, std::memory_order_relaxed);
+              at_v += at_w;
+            }
+          }
+
+          std::atomic_ref<long long>(_triangles[v]).fetch_add(at_v, std::memory_order_relaxed);
+          partial[tid] += at_v;
+        } },
+      threads, 64);
+
+  for (long long c : partial)
+  {
+    _count += c;
+  }
+}
+
+TriangleCounting::TriangleCounting(const Graph &g, int threads) : TriangleCounting(CSRGraph(g), threads) {}
+
+long long TriangleCounting::count() const { return _count; }
+
+long long TriangleCounting::triangles(int v) const { return _triangles[v]; }
+
+double TriangleCounting::clustering(int v) const
+{
+  long long d = _degree[v];
+  return d < 2 ? 0.0 : 2.0 * _triangles[v] / (d * (d - 1));
+}
+
+double TriangleCounting::average_clustering() const
+{
+  if (_degree.empty())
+  {
+    return 0.0;
+  }
+
+  double sum = 0;
+  for (int v = 0; v < static_cast<int>(_degree.size()); v++)
+  {
+    sum += clustering(v);
+  }
+
+  return sum / _degree.size();
+}
+
+long long TriangleCounting::intersection_size(std::span<const int> a, std::span<const int> b)
+{
+  long long n = 0;
+  intersect(a, b, [&n](int)
+            { n++; });
+  return n;
+}
@@ -0,0 +1,642 @@
+/******************************************************************************
+ *  File: alg_weighted_graphs.cpp
+ *
+ *  An implementation file of the edge-weighted graph and the single-source
+ *  shortest path classes, instantiated for long long and double weights.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "alg_parallel.h"
+#include "alg_weighted_graphs.h"
+
+/******************************************************************************
+ *  Class: BasicEdgeWeightedGraph
+ *  A CSRGraph with a weight next to every arc.
+ ******************************************************************************/
+// Constructors
+template <class Weight>
+BasicEdgeWeightedGraph<Weight>::BasicEdgeWeightedGraph() {}
+
+template <class Weight>
+BasicEdgeWeightedGraph<Weight>::BasicEdgeWeightedGraph(int V, const std::vector<Edge> &edges, bool directed)
+{
+  std::vector<long long> offsets(V + 1, 0);
+  for (const Edge &e : edges)
+  {
+    if (e.v < 0 || e.v >= V || e.w < 0 || e.w >= V)
+    {
+      throw std::runtime_error("edge " + std::to_string(e.v) + "-" + std::to_string(e.w) + " is out of range");
+    }
+
+    if (!(e.weight >= 0))
+    {
+      throw std::runtime_error("edge " + std::to_string(e.v) + "-" + std::to_string(e.w) +
+                               " has a negative or NaN weight");
+    }
+
+    offsets[e.v + 1]++;
+    if (!directed)
+    {
+      offsets[e.w + 1]++;
+    }
+    _max_weight = std::max(_max_weight, e.weight);
+  }
+
+  for (int v = 0; v < V; v++)
+  {
+    offsets[v + 1] += offsets[v];
+  }
+
+  std::vector<int> targets(offsets[V]);
+  _weights.resize(offsets[V]);
+  std::vector<long long> cursor(offsets.begin(), offsets.end() - 1);
+  for (const Edge &e : edges)
+  {
+    long long at = cursor[e.v]++;
+    targets[at] = e.w;
+    _weights[at] = e.weight;
+    if (!directed)
+    {
+      at = cursor[e.w]++;
+      targets[at] = e.v;
+      _weights[at] = e.weight;
+    }
+  }
+
+  _topology = CSRGraph(V, std::move(offsets), std::move(targets), directed);
+}
+
+// Vertices and edges
+template <class Weight>
+int BasicEdgeWeightedGraph<Weight>::V() const { return _topology.V(); }
+
+template <class Weight>
+long long BasicEdgeWeightedGraph<Weight>::E() const { return _topology.E(); }
+
+template <class Weight>
+long long BasicEdgeWeightedGraph<Weight>::arcs() const { return _topology.arcs(); }
+
+template <class Weight>
+bool BasicEdgeWeightedGraph<Weight>::is_directed() const { return _topology.is_directed(); }
+
+template <class Weight>
+int BasicEdgeWeightedGraph<Weight>::degree(int v) const { return _topology.degree(v); }
+
+template <class Weight>
+Weight BasicEdgeWeightedGraph<Weight>::max_weight() const { return _max_weight; }
+
+template <class Weight>
+std::span<const int> BasicEdgeWeightedGraph<Weight>::adj(int v) const { return _topology.adj(v); }
+
+template <class Weight>
+std::span<const Weight> BasicEdgeWeightedGraph<Weight>::weights(int v) const
+{
+  std::span<const long long> offsets = _topology.offsets();
+  return std::span<const Weight>(_weights.data() + offsets[v], _weights.data() + offsets[v + 1]);
+}
+
+template <class Weight>
+std::vector<BasicWeightedEdge<Weight>> BasicEdgeWeightedGraph<Weight>::edges() const
+{
+  std::vector<Edge> list;
+  list.reserve(E());
+  for (int v = 0; v < V(); v++)
+  {
+    std::span<const int> targets = adj(v);
+    std::span<const Weight> weight = weights(v);
+    bool skip_loop = false; // Undirected self-loops are stored twice
+    for (std::size_t i = 0; i < targets.size(); i++)
+    {
+      int w = targets[i];
+      if (is_directed() || v < w || (v == w && !(skip_loop = !skip_loop)))
+      {
+        list.push_back({v, w, weight[i]});
+      }
+    }
+  }
+
+  return list;
+}
+
+template <class Weight>
+const CSRGraph &BasicEdgeWeightedGraph<Weight>::topology() const { return _topology; }
+
+// Input/output
+template <class Weight>
+std::string BasicEdgeWeightedGraph<Weight>::str() const
+{
+  std::ostringstream sout;
+  sout << *this;
+  return sout.str();
+}
+
+template <class Weight>
+std::ostream &operator<<(std::ostream &out, const BasicEdgeWeightedGraph<Weight> &g)
+{
+  out << g.V() << std::endl
+      << g.E() << std::endl;
+  for (const BasicWeightedEdge<Weight> &e : g.edges())
+  {
+    out << e.v << " " << e.w << " " << e.weight << std::endl;
+  }
+
+  return out;
+}
+
+template <class Weight>
+BasicEdgeWeightedGraph<Weight> BasicEdgeWeightedGraph<Weight>::read(std::istream &in, bool directed)
+{
+  int V;
+  long long E;
+  if (!(in >> V >> E) || V < 0 || E < 0)
+  {
+    throw std::runtime_error("Malformed weighted graph header");
+  }
+
+  std::vector<Edge> edges(E);
+  for (long long i = 0; i < E; i++)
+  {
+    Edge &e = edges[i];
+    if (!(in >> e.v >> e.w))
+    {
+      throw std::runtime_error("Weighted graph has fewer than " + std::to_string(E) + " edges");
+    }
+
+    // A weight must end at whitespace: "0.16" read as an integer stops at '.'
+    int next;
+    if (!(in >> e.weight) || ((next = in.peek()) != std::istream::traits_type::eof() && !std::isspace(next)))
+    {
+      throw std::runtime_error("Weighted graph edge " + std::to_string(i) + " has a malformed " +
+                               (std::is_integral_v<Weight> ? "integer " : "") + "weight");
+    }
+  }
+
+  return BasicEdgeWeightedGraph(V, edges, directed);
+}
+
+/******************************************************************************
+ *  Class: BasicShortestPaths
+ *  A base class holding distances and a shortest path tree.
+ ******************************************************************************/
+template <class Weight>
+BasicShortestPaths<Weight>::BasicShortestPaths(int V, int s) : s(s), _dist(V, INFINITY_DIST), _parent(V, -1)
+{
+  if (s < 0 || s >= V)
+  {
+    throw std::runtime_error("vertex " + std::to_string(s) + " is not between 0 and " + std::to_string(V - 1));
+  }
+
+  _dist[s] = 0;
+}
+
+template <class Weight>
+int BasicShortestPaths<Weight>::source() const { return s; }
+
+template <class Weight>
+Weight BasicShortestPaths<Weight>::dist_to(int v) const { return _dist[v]; }
+
+template <class Weight>
+bool BasicShortestPaths<Weight>::has_path_to(int v) const { return _dist[v] != INFINITY_DIST; }
+
+template <class Weight>
+std::stack<int> BasicShortestPaths<Weight>::path_to(int v) const
+{
+  std::stack<int> path;
+  if (!has_path_to(v))
+  {
+    return path;
+  }
+
+  for (int x = v; x != -1; x = _parent[x])
+  {
+    path.push(x);
+  }
+
+  return path;
+}
+
+template <class Weight>
+const std::vector<Weight> &BasicShortestPaths<Weight>::distances() const { return _dist; }
+
+template <class Weight>
+BasicShortestPaths<Weight>::~BasicShortestPaths() noexcept {}
+
+/******************************************************************************
+ *  Class: FourAryHeap
+ *  An indexed min-heap of vertices keyed by their tentative distance. With
+ *  four children per node the tree is half as deep as a binary heap and the
+ *  children scanned by a sift-down sit in one cache line.
+ ******************************************************************************/
+template <class Key>
+class FourAryHeap
+{
+private:
+  const std::vector<Key> &key;
+  std::vector<int> heap;
+  std::vector<int> pos; // Index of every vertex in heap, or -1
+
+  void place(int i, int v)
+  {
+    heap[i] = v;
+    pos[v] = i;
+  }
+
+  void sift_up(int i)
+  {
+    int v = heap[i];
+    while (i > 0 && key[heap[(i - 1) / 4]] > key[v])
+    {
+      place(i, heap[(i - 1) / 4]);
+      i = (i - 1) / 4;
+    }
+    place(i, v);
+  }
+
+  void sift_down(int i)
+  {
+    int v = heap[i];
+    int n = static_cast<int>(heap.size());
+    for (;;)
+    {
+      int first = 4 * i + 1;
+      if (first >= n)
+      {
+        break;
+      }
+
+      int best = first;
+      for (int c = first + 1; c < std::min(first + 4, n); c++)
+      {
+        if (key[heap[c]] < key[heap[best]])
+        {
+          best = c;
+        }
+      }
+
+      if (key[heap[best]] >= key[v])
+      {
+        break;
+      }
+
+      place(i, heap[best]);
+      i = best;
+    }
+    place(i, v);
+  }
+
+public:
+  FourAryHeap(int V, const std::vector<Key> &key) : key(key), pos(V, -1) {}
+
+  bool empty() const { return heap.empty(); }
+
+  // Inserts v, or restores the heap after key[v] decreased
+  void push_or_decrease(int v)
+  {
+    if (pos[v] == -1)
+    {
+      heap.push_back(v);
+      pos[v] = static_cast<int>(heap.size()) - 1;
+    }
+    sift_up(pos[v]);
+  }
+
+  int pop()
+  {
+    int top = heap[0];
+    pos[top] = -1;
+    int last = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+    {
+      place(0, last);
+      sift_down(0);
+    }
+
+    return top;
+  }
+};
+
+/******************************************************************************
+ *  Class: RadixHeap
+ *  A monotone priority queue: keys pushed are never below the last key
+ *  popped. An entry lives in the bucket of the highest bit in which its key
+ *  differs from that last key, so it only ever moves to lower buckets.
+ *  Entries are not updated in place; stale ones are skipped by the caller.
+ ******************************************************************************/
+class RadixHeap
+{
+private:
+  std::vector<std::pair<std::uint64_t, int>> buckets[65];
+  std::uint64_t last = 0;
+  long long count = 0;
+
+  int bucket_of(std::uint64_t key) const { return std::bit_width(key ^ last); }
+
+public:
+  bool empty() const { return count == 0; }
+
+  void push(std::uint64_t key, int v)
+  {
+    buckets[bucket_of(key)].push_back({key, v});
+    count++;
+  }
+
+  std::pair<std::uint64_t, int> pop()
+  {
+    if (buckets[0].empty())
+    {
+      int b = 1;
+      while (buckets[b].empty())
+      {
+        b++;
+      }
+
+      last = std::min_element(buckets[b].begin(), buckets[b].end())->first;
+      for (const auto &entry : buckets[b])
+      {
+        buckets[bucket_of(entry.first)].push_back(entry);
+      }
+      buckets[b].clear();
+    }
+
+    auto top = buckets[0].back();
+    buckets[0].pop_back();
+    count--;
+    return top;
+  }
+};
+
+/******************************************************************************
+ *  Class: BasicDijkstraSP
+ *  Dijkstra's algorithm with a 4-ary or a radix heap.
+ ******************************************************************************/
+template <class Weight>
+BasicDijkstraSP<Weight>::BasicDijkstraSP(const BasicEdgeWeightedGraph<Weight> &g, int s, DijkstraHeap heap)
+    : BasicShortestPaths<Weight>(g.V(), s)
+{
+  std::vector<Weight> &dist = this->_dist;
+  std::vector<int> &parent = this->_parent;
+
+  // Relaxes the arcs of v, calling improved(w) for every w it got closer to
+  auto relax = [&](int v, auto &&improved)
+  {
+    std::span<const int> targets = g.adj(v);
+    std::span<const Weight> weights = g.weights(v);
+    for (std::size_t i = 0; i < targets.size(); i++)
+    {
+      int w = targets[i];
+      Weight d = dist[v] + weights[i];
+      if (d < dist[w])
+      {
+        dist[w] = d;
+        parent[w] = v;
+        improved(w);
+      }
+    }
+  };
+
+  if (heap == DijkstraHeap::FourAry)
+  {
+    FourAryHeap<Weight> pq(g.V(), dist);
+    pq.push_or_decrease(s);
+    while (!pq.empty())
+    {
+      relax(pq.pop(), [&pq](int w)
+            { pq.push_or_decrease(w); });
+    }
+  }
+  else if constexpr (std::is_integral_v<Weight>)
+  {
+    RadixHeap pq;
+    pq.push(0, s);
+    while (!pq.empty())
+    {
+      auto [d, v] = pq.pop();
+      if (static_cast<Weight>(d) == dist[v])
+      {
+        relax(v, [&dist, &pq](int w)
+              { pq.push(dist[w], w); });
+      }
+    }
+  }
+  else
+  {
+    throw std::runtime_error("A radix heap needs integer weights");
+  }
+}
+
+/******************************************************************************
+ *  Class: BasicDeltaSteppingSP
+ *  Parallel delta-stepping.
+ ******************************************************************************/
+template <class Weight>
+BasicDeltaSteppingSP<Weight>::BasicDeltaSteppingSP(const BasicEdgeWeightedGraph<Weight> &g, int s, Weight width,
+                                                   int threads)
+    : BasicShortestPaths<Weight>(g.V(), s), delta(width), threads(resolve_threads(threads))
+{
+  std::vector<Weight> &dist = this->_dist;
+  if (!(delta > 0))
+  {
+    long long average_degree = std::max(1LL, g.arcs() / std::max(1, g.V()));
+    delta = g.max_weight() / static_cast<Weight>(average_degree);
+    if (!(delta > 0))
+    {
+      delta = 1;
+    }
+  }
+
+  if constexpr (std::is_floating_point_v<Weight>)
+  {
+    // Keeps the bucket index of every path length within a long long
+    delta = std::max(delta, g.max_weight() * g.V() / 0x1p62);
+  }
+
+  const Weight range = g.max_weight() / delta;
+  const long long slots = range < MAX_BUCKETS - 2 ? static_cast<long long>(range) + 2 : MAX_BUCKETS;
+  std::vector<std::vector<int>> buckets(slots);
+  std::vector<std::vector<int>> improved(this->threads);
+  std::vector<long long> seen(g.V(), -1), settled(g.V(), -1);
+  long long pending = 1, round = 0;
+  buckets[0].push_back(s);
+
+  // Relaxes the light or heavy arcs of the given vertices in parallel, then
+  // files every vertex that got closer into the bucket of its new distance
+  auto relax_all = [&](const std::vector<int> &from, bool light)
+  {
+    parallel_chunks(
+        0, from.size(), [&](int tid, long long lo, long long hi)
+        {
+          for (long long i = lo; i < hi; i++)
+          {
+            int v = from[i];
+            Weight dv = std::atomic_ref<Weight>(dist[v]).load(std::memory_order_relaxed);
+            std::span<const int> targets = g.adj(v);
+            std::span<const Weight> weights = g.weights(v);
+            for (std::size_t k = 0; k < targets.size(); k++)
+            {
+              if ((weights[k] <= delta) != light)
+              {
+                continue;
+              }
+
+              Weight d = dv + weights[k];
+              std::atomic_ref<Weight> dw(dist[targets[k]]);
+              Weight old = dw.load(std::memory_order_relaxed);
+              while (d < old && !dw.compare_exchange_weak(old, d, std::memory_order_relaxed))
+              {
+              }
+
+              if (d < old)
+              {
+                improved[tid].push_back(targets[k]);
+              }
+            }
+          } },
+        this->threads, 64);
+
+    for (std::vector<int> &local : improved)
+    {
+      for (int w : local)
+      {
+        buckets[bucket_of(dist[w]) % slots].push_back(w);
+      }
+      pending += static_cast<long long>(local.size());
+      local.clear();
+    }
+  };
+
+  std::vector<int> frontier, reached, later;
+  long long idle = 0; // Buckets in a row that had no vertex to settle
+  for (long long i = 0; pending > 0; i++)
+  {
+    // A whole lap found only vertices of later laps: jump to the first
+    if (idle == slots)
+    {
+      long long next = std::numeric_limits<long long>::max();
+      for (const std::vector<int> &bucket : buckets)
+      {
+        for (int v : bucket)
+        {
+          next = std::min(next, bucket_of(dist[v]));
+        }
+      }
+      i = next;
+      idle = 0;
+    }
+
+    std::vector<int> &bucket = buckets[i % slots];
+    reached.clear();
+    for (;;)
+    {
+      // Stale entries (the vertex moved to a lower bucket) and duplicates
+      // are dropped; entries of a later lap stay in the slot
+      frontier.clear();
+      later.clear();
+      for (int v : bucket)
+      {
+        long long b = bucket_of(dist[v]);
+        if (b > i)
+        {
+          later.push_back(v);
+        }
+        else if (b == i && seen[v] != round)
+        {
+          seen[v] = round;
+          frontier.push_back(v);
+          if (settled[v] != i)
+          {
+            settled[v] = i;
+            reached.push_back(v);
+          }
+        }
+      }
+      pending -= static_cast<long long>(bucket.size() - later.size());
+      bucket.swap(later);
+      if (frontier.empty())
+      {
+        break;
+      }
+      round++;
+
+      relax_all(frontier, true);
+    }
+
+    idle = reached.empty() ? idle + 1 : 0;
+    relax_all(reached, false);
+  }
+
+  build_tree(g);
+}
+
+template <class Weight>
+long long BasicDeltaSteppingSP<Weight>::bucket_of(Weight d) const
+{
+  return static_cast<long long>(d / delta);
+}
+
+// Picks a parent for every reached vertex among the arcs that are tight
+// (dist[v] + weight == dist[w]). A BFS over them from the source keeps the
+// tree acyclic even across zero-weight cycles.
+template <class Weight>
+void BasicDeltaSteppingSP<Weight>::build_tree(const BasicEdgeWeightedGraph<Weight> &g)
+{
+  const std::vector<Weight> &dist = this->_dist;
+  std::vector<int> &parent = this->_parent;
+  std::vector<unsigned char> visited(g.V(), 0);
+  std::vector<int> frontier = {this->s};
+  std::vector<std::vector<int>> next(threads);
+  visited[this->s] = 1;
+  while (!frontier.empty())
+  {
+    parallel_chunks(
+        0, frontier.size(), [&](int tid, long long lo, long long hi)
+        {
+          for (long long i = lo; i < hi; i++)
+          {
+            int v = frontier[i];
+            std::span<const int> targets = g.adj(v);
+            std::span<const Weight> weights = g.weights(v);
+            for (std::size_t k = 0; k < targets.size(); k++)
+            {
+              int w = targets[k];
+              if (dist[v] + weights[k] == dist[w] && !std::atomic_ref<unsigned char>(visited[w]).exchange(1))
+              {
+                parent[w] = v;
+                next[tid].push_back(w);
+              }
+            }
+          } },
+        threads, 256);
+
+    frontier.clear();
+    for (std::vector<int> &local : next)
+    {
+      frontier.insert(frontier.end(), local.begin(), local.end());
+      local.clear();
+    }
+  }
+}
+
+template <class Weight>
+Weight BasicDeltaSteppingSP<Weight>::bucket_width() const { return delta; }
+
+template struct BasicWeightedEdge<long long>;
+template struct BasicWeightedEdge<double>;
+template class BasicEdgeWeightedGraph<long long>;
+template class BasicEdgeWeightedGraph<double>;
+template std::ostream &operator<<(std::ostream &out, const BasicEdgeWeightedGraph<long long> &g);
+template std::ostream &operator<<(std::ostream &out, const BasicEdgeWeightedGraph<double> &g);
+template class BasicShortestPaths<long long>;
+template class BasicShortestPaths<double>;
+template class BasicDijkstraSP<long long>;
+template class BasicDijkstraSP<double>;
+template class BasicDeltaSteppingSP<long long>;
+template class BasicDeltaSteppingSP<double>;
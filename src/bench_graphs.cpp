@@ -0,0 +1,432 @@
+/******************************************************************************
+ *  File: bench_graphs.cpp
+ *
+ *  A benchmark of the graph classes. For every input graph (the files under
+ *  resources/ and generated R-MAT, G(n, m), grid and chain graphs) it times
+ *  loading (or generating, then filling), DFS, reversing, components, BFS
+ *  and edge queries, each on the representations that support it, after
+ *  warmup runs. The Graph and Digraph rows are labeled "arena", after the
+ *  AdjacencyArena backing their lists. Results are reported as percentiles
+ *  of the running time, traversed edges (or queries) per second and the
+ *  peak resident memory during each measurement, on the console and
+ *  optionally as CSV and JSON.
+ *
+ *  Usage: bench_graphs [--reps N] [--warmup N] [--scale S] [--edge-factor F]
+ *                      [--threads T] [--resources DIR] [--csv FILE]
+ *                      [--json FILE]
+ ******************************************************************************/
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "alg_compressed_graph.h"
+#include "alg_csr.h"
+#include "alg_graph_generators.h"
+#include "alg_graph_io.h"
+#include "alg_graphs.h"
+#include "alg_scc.h"
+#include "alg_stopwatch.h"
+#include "alg_uf.h"
+
+using namespace std;
+
+// Command line settings
+struct Settings
+{
+  int reps = 5;
+  int warmup = 1;
+  int scale = 16;
+  int edge_factor = 16;
+  int threads = 0;
+  string resources = "../resources/";
+  string csv, json;
+};
+
+// One timed operation on one input and representation
+struct BenchResult
+{
+  string input;
+  string representation;
+  string operation;
+  string unit; // What `work` counts: traversed edges or queries
+  long long work = 0;
+  vector<double> times_ms;
+  long peak_rss_kb = 0;
+};
+
+// An input graph: a file to load or a generator to run
+struct BenchInput
+{
+  string name;
+  bool directed = true;
+  string path;                         // File inputs
+  function<GeneratedGraph()> generate; // Generated inputs
+};
+
+// Starts a new peak resident memory measurement. Needs Linux 4.0 or later;
+// elsewhere the peak stays the one of the whole process.
+void ResetPeakRSS()
+{
+  ofstream("/proc/self/clear_refs") << "5";
+}
+
+// Peak resident set size since the last ResetPeakRSS, in kilobytes
+long PeakRSS()
+{
+  ifstream status("/proc/self/status");
+  string line;
+  while (getline(status, line))
+  {
+    if (line.rfind("VmHWM:", 0) == 0)
+    {
+      return stol(line.substr(6));
+    }
+  }
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss; // Kilobytes on Linux
+}
+
+// Nearest-rank percentile of sorted times
+double Percentile(const vector<double> &sorted, double p)
+{
+  size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.999999);
+  return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+// Times `op` settings.reps times after settings.warmup untimed runs
+BenchResult Measure(const Settings &settings, const string &input, const string &representation,
+                    const string &operation, const string &unit, long long work, const function<void()> &op)
+{
+  BenchResult result;
+  result.input = input;
+  result.representation = representation;
+  result.operation = operation;
+  result.unit = unit;
+  result.work = work;
+
+  ResetPeakRSS();
+  for (int i = 0; i < settings.warmup; i++)
+  {
+    op();
+  }
+
+  for (int i = 0; i < settings.reps; i++)
+  {
+    StopWatch sw;
+    op();
+    result.times_ms.push_back(sw.elapsed_time_milli_seconds());
+  }
+
+  sort(result.times_ms.begin(), result.times_ms.end());
+  result.peak_rss_kb = PeakRSS();
+  return result;
+}
+
+// Work done per second at the median running time
+double Rate(const BenchResult &r)
+{
+  double median = Percentile(r.times_ms, 50);
+  return median > 0 ? r.work / (median / 1000.0) : 0;
+}
+
+// Breadth-first search from every unvisited vertex; returns traversed arcs
+template <class G>
+long long BreadthFirstSearch(const G &g)
+{
+  vector<char> visited(g.V(), 0);
+  vector<int> queue;
+  queue.reserve(g.V());
+  long long traversed = 0;
+  for (int s = 0; s < g.V(); s++)
+  {
+    if (visited[s])
+    {
+      continue;
+    }
+
+    visited[s] = 1;
+    queue.assign(1, s);
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+      for (int w : g.adj(queue[head]))
+      {
+        traversed++;
+        if (!visited[w])
+        {
+          visited[w] = 1;
+          queue.push_back(w);
+        }
+      }
+    }
+  }
+
+  return traversed;
+}
+
+// Benchmarks every operation on one input
+void BenchmarkInput(const Settings &settings, const BenchInput &input, vector<BenchResult> &results)
+{
+  cout << "Benchmarking " << input.name << "..." << endl;
+  auto make = [&input]() -> unique_ptr<BaseGraph>
+  {
+    if (input.directed)
+    {
+      return make_unique<Digraph>();
+    }
+    return make_unique<Graph>();
+  };
+
+  // Files are timed from parsing to filled lists; generated graphs are
+  // timed generating and filling separately
+  unique_ptr<BaseGraph> g = make();
+  if (input.generate)
+  {
+    GeneratedGraph generated = input.generate();
+    generated.fill(*g);
+    results.push_back(Measure(settings, input.name, "edge-list", "generate", "edges", g->E(), [&]()
+                              { input.generate(); }));
+    results.push_back(Measure(settings, input.name, "arena", "fill", "edges", g->E(), [&]()
+                              {
+      unique_ptr<BaseGraph> h = make();
+      generated.fill(*h); }));
+  }
+  else
+  {
+    GraphLoader::load(input.path, *g, settings.threads);
+    results.push_back(Measure(settings, input.name, "arena", "load", "edges", g->E(), [&]()
+                              {
+      unique_ptr<BaseGraph> h = make();
+      GraphLoader::load(input.path, *h, settings.threads); }));
+  }
+
+  CSRGraph csr(*g);
+  CompressedGraph compressed(csr, settings.threads);
+  const long long arcs = csr.arcs();
+
+  results.push_back(Measure(settings, input.name, "arena", "dfs", "edges", arcs, [&]()
+                            { DepthFirstSearch dfs(*g); }));
+
+  if (input.directed)
+  {
+    Digraph &d = static_cast<Digraph &>(*g);
+    results.push_back(Measure(settings, input.name, "arena", "reverse", "edges", arcs, [&]()
+                              { Digraph r = d.reverse(); }));
+    results.push_back(Measure(settings, input.name, "csr", "reverse", "edges", arcs, [&]()
+                              { CSRGraph r = csr.transpose(); }));
+    results.push_back(Measure(settings, input.name, "csr", "components", "edges", arcs, [&]()
+                              { TarjanSCC scc(csr); }));
+    results.push_back(Measure(settings, input.name, "csr", "parallel-components", "edges", arcs, [&]()
+                              { ParallelSCC scc(csr, settings.threads); }));
+  }
+  else
+  {
+    results.push_back(Measure(settings, input.name, "arena", "components", "edges", arcs, [&]()
+                              { DepthFirstSearch(*g).components_count(); }));
+    results.push_back(Measure(settings, input.name, "csr", "components", "edges", arcs, [&]()
+                              {
+      PCWQuickUF uf(csr.V());
+      for (int v = 0; v < csr.V(); v++)
+      {
+        for (int w : csr.adj(v))
+        {
+          uf._union(v, w);
+        }
+      } }));
+  }
+
+  results.push_back(Measure(settings, input.name, "csr", "bfs", "edges", arcs, [&]()
+                            { BreadthFirstSearch(csr); }));
+  results.push_back(Measure(settings, input.name, "compressed", "bfs", "edges", arcs, [&]()
+                            { BreadthFirstSearch(compressed); }));
+
+  // The same random vertex pairs for every representation
+  const int queries = 100000;
+  vector<pair<int, int>> pairs(queries);
+  mt19937 rng(1);
+  uniform_int_distribution<int> vertex(0, max(0, g->V() - 1));
+  for (auto &p : pairs)
+  {
+    p = {vertex(rng), vertex(rng)};
+  }
+
+  if (g->V() > 0)
+  {
+    results.push_back(Measure(settings, input.name, "arena", "edge-query", "queries", queries, [&]()
+                              {
+      for (auto [v, w] : pairs)
+      {
+        g->edge(v, w);
+      } }));
+    results.push_back(Measure(settings, input.name, "csr", "edge-query", "queries", queries, [&]()
+                              {
+      for (auto [v, w] : pairs)
+      {
+        csr.edge(v, w);
+      } }));
+    results.push_back(Measure(settings, input.name, "compressed", "edge-query", "queries", queries, [&]()
+                              {
+      for (auto [v, w] : pairs)
+      {
+        compressed.edge(v, w);
+      } }));
+  }
+}
+
+// Write results to csv file
+void WriteResultsToCSV(const string &filename, const vector<BenchResult> &results)
+{
+  ofstream file(filename);
+  if (!file)
+  {
+    cerr << "Unable to open file " << filename << " for writing." << endl;
+    return;
+  }
+
+  file << "Input,Representation,Operation,Unit,Work,Reps,MinMs,P50Ms,P90Ms,P99Ms,MaxMs,RatePerSec,PeakRssKb\n";
+  for (const BenchResult &r : results)
+  {
+    file << r.input << "," << r.representation << "," << r.operation << "," << r.unit << "," << r.work << ","
+         << r.times_ms.size() << "," << r.times_ms.front() << "," << Percentile(r.times_ms, 50) << ","
+         << Percentile(r.times_ms, 90) << "," << Percentile(r.times_ms, 99) << "," << r.times_ms.back() << ","
+         << Rate(r) << "," << r.peak_rss_kb << "\n";
+  }
+}
+
+// Write results to json file
+void WriteResultsToJSON(const string &filename, const vector<BenchResult> &results)
+{
+  ofstream file(filename);
+  if (!file)
+  {
+    cerr << "Unable to open file " << filename << " for writing." << endl;
+    return;
+  }
+
+  file << "[\n";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const BenchResult &r = results[i];
+    file << "  {\"input\": \"" << r.input << "\", \"representation\": \"" << r.representation
+         << "\", \"operation\": \"" << r.operation << "\", \"unit\": \"" << r.unit << "\", \"work\": " << r.work
+         << ", \"times_ms\": [";
+    for (size_t k = 0; k < r.times_ms.size(); k++)
+    {
+      file << (k ? ", " : "") << r.times_ms[k];
+    }
+    file << "], \"p50_ms\": " << Percentile(r.times_ms, 50) << ", \"p90_ms\": " << Percentile(r.times_ms, 90)
+         << ", \"p99_ms\": " << Percentile(r.times_ms, 99) << ", \"rate_per_sec\": " << Rate(r)
+         << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  file << "]\n";
+}
+
+// Console report, one line per result
+void PrintReport(const vector<BenchResult> &results)
+{
+  cout << setw(16) << "Input" << setw(12) << "Repr" << setw(21) << "Operation" << setw(12) << "P50(ms)"
+       << setw(12) << "P90(ms)" << setw(14) << "Rate(/s)" << setw(10) << "Unit" << setw(12) << "RSS(KB)" << endl;
+  cout << string(109, '=') << endl;
+  for (const BenchResult &r : results)
+  {
+    cout << setw(16) << r.input << setw(12) << r.representation << setw(21) << r.operation << setw(12)
+         << fixed << setprecision(3) << Percentile(r.times_ms, 50) << setw(12) << Percentile(r.times_ms, 90)
+         << setw(14) << scientific << setprecision(3) << Rate(r) << defaultfloat << setw(10) << r.unit
+         << setw(12) << r.peak_rss_kb << endl;
+  }
+}
+
+/******************************************************************************
+ *  Main program benchmarking the graph representations and algorithms.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  Settings settings;
+  for (int i = 1; i < argc; i++)
+  {
+    string arg = argv[i];
+    if (i + 1 >= argc)
+    {
+      cerr << "Missing value for " << arg << endl;
+      return 1;
+    }
+
+    string value = argv[++i];
+    if (arg == "--reps")
+      settings.reps = max(1, stoi(value));
+    else if (arg == "--warmup")
+      settings.warmup = max(0, stoi(value));
+    else if (arg == "--scale")
+      settings.scale = stoi(value);
+    else if (arg == "--edge-factor")
+      settings.edge_factor = stoi(value);
+    else if (arg == "--threads")
+      settings.threads = stoi(value);
+    else if (arg == "--resources")
+      settings.resources = value + "/";
+    else if (arg == "--csv")
+      settings.csv = value;
+    else if (arg == "--json")
+      settings.json = value;
+    else
+    {
+      cerr << "Usage: " << argv[0] << " [--reps N] [--warmup N] [--scale S] [--edge-factor F] [--threads T]"
+           << " [--resources DIR] [--csv FILE] [--json FILE]" << endl;
+      return 1;
+    }
+  }
+
+  vector<BenchInput> inputs;
+  for (auto [file, directed] : {pair<string, bool>{"tinyDG.txt", true}, {"testDG.txt", true}, {"mediumUG.txt", false}})
+  {
+    inputs.push_back({file, directed, settings.resources + file, nullptr});
+  }
+
+  // Generated graphs of about the same size
+  const int V = 1 << settings.scale;
+  const long long E = static_cast<long long>(V) * settings.edge_factor;
+  const int side = static_cast<int>(sqrt(V));
+  inputs.push_back({"rmat-" + to_string(settings.scale), true, "", [&settings, E]()
+                    { return GraphGenerator::rmat(settings.scale, E, 1, true, settings.threads); }});
+  inputs.push_back({"gnm-" + to_string(settings.scale), false, "", [&settings, V, E]()
+                    { return GraphGenerator::gnm(V, E / 2, 1, false, settings.threads); }});
+  inputs.push_back({"grid-" + to_string(side), false, "", [&settings, side]()
+                    { return GraphGenerator::grid(side, side, false, settings.threads); }});
+  inputs.push_back({"chain-" + to_string(settings.scale), true, "", [V]()
+                    { return GraphGenerator::chain(V, true); }});
+
+  vector<BenchResult> results;
+  for (const BenchInput &input : inputs)
+  {
+    try
+    {
+      BenchmarkInput(settings, input, results);
+    }
+    catch (const exception &e)
+    {
+      cerr << "Skipping " << input.name << ": " << e.what() << endl;
+    }
+  }
+
+  PrintReport(results);
+  if (!settings.csv.empty())
+  {
+    WriteResultsToCSV(settings.csv, results);
+  }
+
+  if (!settings.json.empty())
+  {
+    WriteResultsToJSON(settings.json, results);
+  }
+
+  return 0;
+}
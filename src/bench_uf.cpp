@@ -0,0 +1,501 @@
+/******************************************************************************
+ *  File: bench_uf.cpp
+ *
+ *  A benchmark of the union-find classes. Every input (tinyUF.txt and
+ *  mediumUF.txt under resources/, plus generated uniform and R-MAT pair
+ *  streams) is parsed or generated before timing starts. Each algorithm
+ *  then unions the whole stream, after warmup runs, and is reported by the
+ *  percentiles of its running time, nanoseconds per union, the depth
+ *  distribution of the trees it left, the memory they take and the peak
+ *  resident memory during the measurement. The quadratic classes (UF,
+ *  QuickUF) only run on inputs with at most --slow-limit elements. R-MAT
+ *  needs a power-of-two number of vertices, so its pairs are generated on
+ *  the next power of two and folded onto exactly --elements elements.
+ *
+ *  Usage: bench_uf [--reps N] [--warmup N] [--elements N] [--pairs P]
+ *                  [--slow-limit N] [--threads T] [--resources DIR]
+ *                  [--csv FILE]
+ ******************************************************************************/
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "alg_graph_generators.h"
+#include "alg_graph_io.h"
+#include "alg_stopwatch.h"
+#include "alg_uf.h"
+
+using namespace std;
+
+// Command line settings
+struct Settings
+{
+  int reps = 5;
+  int warmup = 1;
+  int elements = 1 << 20;
+  long long pairs = 10000000;
+  int slow_limit = 5000;
+  int threads = 0;
+  string resources = "../resources/";
+  string csv;
+};
+
+// A union-find input: N elements and the pairs to union, in order
+struct UFInput
+{
+  string name;
+  int N = 0;
+  vector<pair<int, int>> pairs;
+};
+
+// One algorithm run over one input
+struct BenchResult
+{
+  string input;
+  string algorithm;
+  int N = 0;
+  long long pairs = 0;
+  int components = 0;
+  vector<double> times_ms;
+  vector<long long> depths; // depths[d] = elements at depth d
+  long long memory_bytes = 0;
+  long peak_rss_kb = 0;
+};
+
+// Starts a new peak resident memory measurement. Needs Linux 4.0 or later;
+// elsewhere the peak stays the one of the whole process.
+void ResetPeakRSS()
+{
+  ofstream("/proc/self/clear_refs") << "5";
+}
+
+// Peak resident set size since the last ResetPeakRSS, in kilobytes
+long PeakRSS()
+{
+  ifstream status("/proc/self/status");
+  string line;
+  while (getline(status, line))
+  {
+    if (line.rfind("VmHWM:", 0) == 0)
+    {
+      return stol(line.substr(6));
+    }
+  }
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss; // Kilobytes on Linux
+}
+
+// Nearest-rank percentile of sorted times
+double Percentile(const vector<double> &sorted, double p)
+{
+  size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.999999);
+  return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+// Parses "N" followed by "p q" pairs straight from a mapped file
+UFInput ReadUF(const string &path, const string &name)
+{
+  MappedFile file(path);
+  const char *at = file.data();
+  const char *end = at + file.size();
+  auto next = [&](long long &value) -> bool
+  {
+    while (at < end && (*at < '0' || *at > '9'))
+    {
+      if (*at != ' ' && *at != '\t' && *at != '\r' && *at != '\n')
+      {
+        throw runtime_error(path + ": unexpected character '" + string(1, *at) + "'");
+      }
+      at++;
+    }
+
+    if (at == end)
+    {
+      return false;
+    }
+
+    value = 0;
+    while (at < end && *at >= '0' && *at <= '9')
+    {
+      value = 10 * value + (*at++ - '0');
+    }
+    return true;
+  };
+
+  UFInput input;
+  input.name = name;
+  long long n, p, q;
+  if (!next(n))
+  {
+    throw runtime_error(path + ": missing number of elements");
+  }
+
+  input.N = static_cast<int>(n);
+  while (next(p))
+  {
+    if (!next(q) || p >= n || q >= n)
+    {
+      throw runtime_error(path + ": bad pair after " + to_string(input.pairs.size()) + " pairs");
+    }
+    input.pairs.push_back({static_cast<int>(p), static_cast<int>(q)});
+  }
+
+  return input;
+}
+
+// Uniformly random pairs
+UFInput UniformPairs(int N, long long pairs)
+{
+  UFInput input;
+  input.name = "uniform-" + to_string(N);
+  input.N = N;
+  input.pairs.resize(pairs);
+  mt19937_64 rng(1);
+  uniform_int_distribution<int> element(0, N - 1);
+  for (auto &p : input.pairs)
+  {
+    p = {element(rng), element(rng)};
+  }
+
+  return input;
+}
+
+// Skewed pairs: the edges of an R-MAT graph, in generation order. The graph
+// has the next power of two vertices; ids from N up are folded below N
+// (ids are scrambled, so this does not favor the low ones)
+UFInput RMATPairs(int N, long long pairs, int threads)
+{
+  int scale = 0;
+  while ((1LL << scale) < N)
+  {
+    scale++;
+  }
+
+  GeneratedGraph g = GraphGenerator::rmat(scale, pairs, 1, false, threads);
+  UFInput input;
+  input.name = "rmat-" + to_string(N);
+  input.N = N;
+  input.pairs = move(g.edges);
+  for (auto &[p, q] : input.pairs)
+  {
+    p %= N;
+    q %= N;
+  }
+
+  return input;
+}
+
+// Depth histogram of a parent forest; is_root(v) tells whether v is a root
+template <class IsRoot>
+vector<long long> DepthHistogram(const vector<int> &parent, IsRoot is_root)
+{
+  const int N = static_cast<int>(parent.size());
+  vector<int> depth(N, -1);
+  vector<int> path;
+  vector<long long> histogram;
+  for (int v = 0; v < N; v++)
+  {
+    int u = v;
+    while (depth[u] == -1 && !is_root(u))
+    {
+      path.push_back(u);
+      u = parent[u];
+    }
+
+    if (depth[u] == -1)
+    {
+      depth[u] = 0;
+    }
+
+    for (int d = depth[u] + 1; !path.empty(); d++)
+    {
+      depth[path.back()] = d;
+      path.pop_back();
+    }
+
+    if (static_cast<int>(histogram.size()) <= depth[v])
+    {
+      histogram.resize(depth[v] + 1);
+    }
+    histogram[depth[v]]++;
+  }
+
+  return histogram;
+}
+
+// Access to the storage of the union-find classes, for the depth report
+template <class U>
+struct Inspect : U
+{
+  using U::U;
+
+  vector<long long> depths() const
+  {
+    if constexpr (requires { this->id; })
+    {
+      return DepthHistogram(this->id, [this](int v) { return this->id[v] == v; });
+    }
+    else
+    {
+      return DepthHistogram(this->parent, [this](int v) { return this->parent[v] < 0; });
+    }
+  }
+
+  long long bytes() const
+  {
+    if constexpr (requires { this->sz; })
+    {
+      return (this->id.capacity() + this->sz.capacity()) * sizeof(int);
+    }
+    else if constexpr (requires { this->id; })
+    {
+      return this->id.capacity() * sizeof(int);
+    }
+    else
+    {
+      return this->parent.capacity() * sizeof(int);
+    }
+  }
+};
+
+// Times union-find U over the input settings.reps times, after warmup runs
+template <class U>
+BenchResult Measure(const Settings &settings, const UFInput &input, const string &algorithm,
+                    const function<void(Inspect<U> &)> &unite)
+{
+  BenchResult result;
+  result.input = input.name;
+  result.algorithm = algorithm;
+  result.N = input.N;
+  result.pairs = static_cast<long long>(input.pairs.size());
+
+  ResetPeakRSS();
+  for (int i = 0; i < settings.warmup; i++)
+  {
+    Inspect<U> uf(input.N);
+    unite(uf);
+  }
+
+  for (int i = 0; i < settings.reps; i++)
+  {
+    Inspect<U> uf(input.N);
+    StopWatch sw;
+    unite(uf);
+    result.times_ms.push_back(sw.elapsed_time_milli_seconds());
+
+    if (i + 1 == settings.reps)
+    {
+      result.components = uf.components_count();
+      result.depths = uf.depths();
+      result.memory_bytes = uf.bytes();
+    }
+  }
+
+  sort(result.times_ms.begin(), result.times_ms.end());
+  result.peak_rss_kb = PeakRSS();
+  return result;
+}
+
+// Unions every pair one call at a time
+template <class U>
+function<void(Inspect<U> &)> OneByOne(const UFInput &input)
+{
+  return [&input](Inspect<U> &uf)
+  {
+    for (auto [p, q] : input.pairs)
+    {
+      uf._union(p, q);
+    }
+  };
+}
+
+// Benchmarks every algorithm on one input
+void BenchmarkInput(const Settings &settings, const UFInput &input, vector<BenchResult> &results)
+{
+  cout << "Benchmarking " << input.name << "..." << endl;
+  if (input.N <= settings.slow_limit)
+  {
+    results.push_back(Measure<UF>(settings, input, "UF", OneByOne<UF>(input)));
+    results.push_back(Measure<QuickUF>(settings, input, "QuickUF", OneByOne<QuickUF>(input)));
+    results.push_back(Measure<PackedUF>(settings, input, "PackedUF", OneByOne<PackedUF>(input)));
+    results.push_back(Measure<PackedQuickUF>(settings, input, "PackedQuickUF", OneByOne<PackedQuickUF>(input)));
+  }
+
+  results.push_back(Measure<WeightedQuickUF>(settings, input, "WeightedQuickUF", OneByOne<WeightedQuickUF>(input)));
+  results.push_back(Measure<PCWQuickUF>(settings, input, "PCWQuickUF", OneByOne<PCWQuickUF>(input)));
+  results.push_back(Measure<PackedWeightedQuickUF>(settings, input, "PackedWeightedQuickUF",
+                                                   OneByOne<PackedWeightedQuickUF>(input)));
+  results.push_back(Measure<PackedPCWQuickUF>(settings, input, "PackedPCWQuickUF", OneByOne<PackedPCWQuickUF>(input)));
+  results.push_back(Measure<PackedPCWQuickUF>(settings, input, "PackedPCWQuickUF-batch",
+                                              [&input](Inspect<PackedPCWQuickUF> &uf)
+                                              { uf.union_batch(input.pairs); }));
+  results.push_back(Measure<ConcurrentUF>(settings, input, "ConcurrentUF",
+                                          [&input, &settings](Inspect<ConcurrentUF> &uf)
+                                          { uf.union_all(input.pairs, settings.threads); }));
+}
+
+// Nanoseconds per union at the median running time
+double NanosPerOp(const BenchResult &r)
+{
+  return r.pairs > 0 ? Percentile(r.times_ms, 50) * 1e6 / r.pairs : 0;
+}
+
+// Mean and maximum depth of the elements
+double MeanDepth(const BenchResult &r)
+{
+  long long total = 0, weighted = 0;
+  for (size_t d = 0; d < r.depths.size(); d++)
+  {
+    total += r.depths[d];
+    weighted += d * r.depths[d];
+  }
+  return total > 0 ? static_cast<double>(weighted) / total : 0;
+}
+
+// "count@depth" for the first few depths, the rest folded into the last
+string DepthSummary(const BenchResult &r)
+{
+  const size_t shown = 4;
+  string summary;
+  for (size_t d = 0; d < r.depths.size() && d <= shown; d++)
+  {
+    long long count = r.depths[d];
+    if (d == shown)
+    {
+      for (size_t k = d + 1; k < r.depths.size(); k++)
+      {
+        count += r.depths[k];
+      }
+    }
+    summary += (d ? " " : "") + to_string(d) + (d == shown && r.depths.size() > shown + 1 ? "+:" : ":") +
+               to_string(count);
+  }
+  return summary;
+}
+
+// Write results to csv file
+void WriteResultsToCSV(const string &filename, const vector<BenchResult> &results)
+{
+  ofstream file(filename);
+  if (!file)
+  {
+    cerr << "Unable to open file " << filename << " for writing." << endl;
+    return;
+  }
+
+  file << "Input,Algorithm,N,Pairs,Components,Reps,MinMs,P50Ms,P90Ms,P99Ms,MaxMs,NsPerOp,MeanDepth,MaxDepth,"
+          "DepthHistogram,MemoryBytes,PeakRssKb\n";
+  for (const BenchResult &r : results)
+  {
+    file << r.input << "," << r.algorithm << "," << r.N << "," << r.pairs << "," << r.components << ","
+         << r.times_ms.size() << "," << r.times_ms.front() << "," << Percentile(r.times_ms, 50) << ","
+         << Percentile(r.times_ms, 90) << "," << Percentile(r.times_ms, 99) << "," << r.times_ms.back() << ","
+         << NanosPerOp(r) << "," << MeanDepth(r) << "," << r.depths.size() - 1 << ",";
+    for (size_t d = 0; d < r.depths.size(); d++)
+    {
+      file << (d ? " " : "") << r.depths[d];
+    }
+    file << "," << r.memory_bytes << "," << r.peak_rss_kb << "\n";
+  }
+}
+
+// Console report, one line per result
+void PrintReport(const vector<BenchResult> &results)
+{
+  cout << setw(14) << "Input" << setw(24) << "Algorithm" << setw(10) << "N" << setw(11) << "Pairs" << setw(11)
+       << "Components" << setw(12) << "P50(ms)" << setw(10) << "ns/op" << setw(8) << "Depth" << setw(6) << "Max"
+       << setw(12) << "Mem(KB)" << "  Depths" << endl;
+  cout << string(150, '=') << endl;
+  for (const BenchResult &r : results)
+  {
+    cout << setw(14) << r.input << setw(24) << r.algorithm << setw(10) << r.N << setw(11) << r.pairs << setw(11)
+         << r.components << fixed << setprecision(3) << setw(12) << Percentile(r.times_ms, 50) << setprecision(1)
+         << setw(10) << NanosPerOp(r) << setprecision(2) << setw(8) << MeanDepth(r) << defaultfloat << setw(6)
+         << r.depths.size() - 1 << setw(12) << r.memory_bytes / 1024 << "  " << DepthSummary(r) << endl;
+  }
+}
+
+/******************************************************************************
+ *  Main program benchmarking the union-find classes.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  Settings settings;
+  for (int i = 1; i < argc; i++)
+  {
+    string arg = argv[i];
+    if (i + 1 >= argc)
+    {
+      cerr << "Missing value for " << arg << endl;
+      return 1;
+    }
+
+    string value = argv[++i];
+    if (arg == "--reps")
+      settings.reps = max(1, stoi(value));
+    else if (arg == "--warmup")
+      settings.warmup = max(0, stoi(value));
+    else if (arg == "--elements")
+      settings.elements = max(1, stoi(value));
+    else if (arg == "--pairs")
+      settings.pairs = max(0LL, stoll(value));
+    else if (arg == "--slow-limit")
+      settings.slow_limit = stoi(value);
+    else if (arg == "--threads")
+      settings.threads = stoi(value);
+    else if (arg == "--resources")
+      settings.resources = value + "/";
+    else if (arg == "--csv")
+      settings.csv = value;
+    else
+    {
+      cerr << "Usage: " << argv[0] << " [--reps N] [--warmup N] [--elements N] [--pairs P] [--slow-limit N]"
+           << " [--threads T] [--resources DIR] [--csv FILE]" << endl;
+      return 1;
+    }
+  }
+
+  // Every input is read or generated before anything is timed
+  vector<function<UFInput()>> sources;
+  for (string file : {"tinyUF.txt", "mediumUF.txt"})
+  {
+    string path = settings.resources + file;
+    sources.push_back([path, file]()
+                      { return ReadUF(path, file); });
+  }
+  sources.push_back([&settings]()
+                    { return UniformPairs(settings.elements, settings.pairs); });
+  sources.push_back([&settings]()
+                    { return RMATPairs(settings.elements, settings.pairs, settings.threads); });
+
+  vector<BenchResult> results;
+  for (const auto &source : sources)
+  {
+    try
+    {
+      UFInput input = source();
+      BenchmarkInput(settings, input, results);
+    }
+    catch (const exception &e)
+    {
+      cerr << "Skipping input: " << e.what() << endl;
+    }
+  }
+
+  PrintReport(results);
+  if (!settings.csv.empty())
+  {
+    WriteResultsToCSV(settings.csv, results);
+  }
+
+  return 0;
+}
@@ -1,6 +1,1657 @@
 #define CATCH_CONFIG_MAIN // Tells Catch2 to provide a main() function
 #include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "alg_graphs.h"
+#include "alg_adjacency_arena.h"
+#include "alg_bidirectional_bfs.h"
+#include "alg_csr.h"
+#include "alg_compressed_graph.h"
+#include "alg_connectivity.h"
+#include "alg_dynamic_connectivity.h"
+#include "alg_dynamic_graph.h"
+#include "alg_graph_generators.h"
+#include "alg_graph_io.h"
+#include "alg_hash.h"
+#include "alg_hybrid_graph.h"
+#include "alg_mst.h"
+#include "alg_pagerank.h"
+#include "alg_reachability.h"
+#include "alg_reorder.h"
+#include "alg_scc.h"
+#include "alg_topological.h"
+#include "alg_traversal.h"
+#include "alg_triangles.h"
+#include "alg_uf.h"
+#include "alg_weighted_graphs.h"
 
 using namespace std;
+
+// Reads one of the graph files under resources/
+template <class G>
+G ReadGraph(const std::string &name)
+{
+	G g;
+	std::ifstream in("../resources/" + name);
+	REQUIRE(in);
+	in >> g;
+	return g;
+}
+
+// A seeded random digraph with a few planted cycles
+CSRGraph RandomDigraph(int V, int E, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> pick(0, V - 1);
+	std::vector<std::pair<int, int>> edges;
+	for (int i = 0; i < E; i++)
+	{
+		edges.push_back({pick(rng), pick(rng)});
+	}
+
+	return CSRGraph::from_edges(V, edges, true);
+}
+
+// The algs4 tinyDG.txt digraph, which has 5 strongly connected components
+CSRGraph Algs4TinyDG()
+{
+	std::vector<std::pair<int, int>> edges = {
+		{4, 2}, {2, 3}, {3, 2}, {6, 0}, {0, 1}, {2, 0}, {11, 12}, {12, 9}, {9, 10}, {9, 11}, {7, 9}, {10, 12}, {11, 4}, {4, 3}, {3, 5}, {6, 8}, {8, 6}, {5, 4}, {0, 5}, {6, 4}, {6, 9}, {7, 6}};
+	return CSRGraph::from_edges(13, edges, true);
+}
+
+TEST_CASE("CSR snapshot matches the adjacency lists", "[CSR]")
+{
+	Digraph g = ReadGraph<Digraph>("tinyDG.txt");
+	CSRGraph csr(g);
+
+	REQUIRE(csr.V() == g.V());
+	REQUIRE(csr.E() == g.E());
+	for (int v = 0; v < g.V(); v++)
+	{
+		std::list<int> expected = g.adj(v);
+		REQUIRE(std::vector<int>(expected.begin(), expected.end()) == std::vector<int>(csr.adj(v).begin(), csr.adj(v).end()));
+	}
+
+	CSRGraph r = csr.transpose();
+	REQUIRE(r.arcs() == csr.arcs());
+	REQUIRE(r.edge(5, 0));
+	REQUIRE(!r.edge(0, 5));
+}
+
+TEST_CASE("Tarjan finds the strongly connected components", "[SCC]")
+{
+	CSRGraph g = Algs4TinyDG();
+	TarjanSCC scc(g);
+
+	REQUIRE(scc.count() == 5);
+	REQUIRE(scc.strongly_connected(0, 2));
+	REQUIRE(scc.strongly_connected(9, 12));
+	REQUIRE(scc.strongly_connected(6, 8));
+	REQUIRE(!scc.strongly_connected(1, 0));
+	REQUIRE(!scc.strongly_connected(7, 6));
+
+	// Condensation edges go from larger to smaller ids and have no duplicates
+	CSRGraph dag = scc.condensation(g);
+	REQUIRE(dag.V() == 5);
+	for (int c = 0; c < dag.V(); c++)
+	{
+		for (int d : dag.adj(c))
+		{
+			REQUIRE(c > d);
+		}
+	}
+	REQUIRE(TarjanSCC(dag).count() == dag.V());
+
+	// tinyDG.txt in resources is acyclic
+	CSRGraph tiny(ReadGraph<Digraph>("tinyDG.txt"));
+	REQUIRE(TarjanSCC(tiny).count() == tiny.V());
+}
+
+TEST_CASE("Parallel SCC agrees with Tarjan", "[SCC]")
+{
+	CSRGraph g = RandomDigraph(20000, 30000, 7);
+	TarjanSCC serial(g);
+	ParallelSCC parallel(g, 4);
+
+	REQUIRE(parallel.count() == serial.count());
+	ParallelSCC outliving(RandomDigraph(20000, 30000, 7), 2); // Outlives its graph
+	REQUIRE(outliving.count() == serial.count());
+	std::vector<int> mapping(serial.count(), -1);
+	for (int v = 0; v < g.V(); v++)
+	{
+		int &m = mapping[serial.id(v)];
+		if (m == -1)
+		{
+			m = parallel.id(v);
+		}
+		REQUIRE(m == parallel.id(v));
+	}
+
+	REQUIRE(parallel.condensation(g).arcs() == serial.condensation(g).arcs());
+
+	// 30 large cycles chained by one-way edges (and a few chords): after the
+	// forward-backward search peels one, far more than SERIAL_CUTOFF vertices
+	// remain in big components, so color propagation has to split them
+	const int cycles = 30, length = 1000;
+	std::vector<std::pair<int, int>> edges;
+	std::mt19937 rng(13);
+	for (int c = 0; c < cycles; c++)
+	{
+		for (int i = 0; i < length; i++)
+		{
+			edges.push_back({c * length + i, c * length + (i + 1) % length});
+		}
+		edges.push_back({c * length + static_cast<int>(rng() % length), c * length + static_cast<int>(rng() % length)});
+		if (c + 1 < cycles)
+		{
+			edges.push_back({c * length + static_cast<int>(rng() % length), (c + 1) * length + static_cast<int>(rng() % length)});
+		}
+	}
+
+	CSRGraph chained = CSRGraph::from_edges(cycles * length, edges, true);
+	REQUIRE(cycles * length - length > ParallelSCC::SERIAL_CUTOFF);
+	for (int threads : {1, 4})
+	{
+		ParallelSCC colored(chained, threads);
+		REQUIRE(colored.count() == cycles);
+		for (int v = 0; v < chained.V(); v++)
+		{
+			REQUIRE(colored.strongly_connected(v, v / length * length));
+			REQUIRE(colored.strongly_connected(v, (v + length) % chained.V()) == (cycles == 1));
+		}
+		REQUIRE(colored.condensation(chained).arcs() == cycles - 1);
+	}
+
+	// Components outlive the graph they were computed from
+	std::vector<std::pair<int, int>> small = {{0, 1}, {1, 0}, {1, 2}};
+	TarjanSCC detached(CSRGraph::from_edges(3, small, true));
+	REQUIRE(detached.count() == 2);
+	REQUIRE(detached.condensation(CSRGraph::from_edges(3, small, true)).arcs() == 1);
+	REQUIRE_THROWS(detached.condensation(Algs4TinyDG()));
+}
+
+TEST_CASE("Topological sort respects every edge and groups waves", "[Topological]")
+{
+	CSRGraph g(ReadGraph<Digraph>("testDG.txt"));
+	TopologicalSort topo(g, 2);
+
+	REQUIRE(topo.is_dag());
+	REQUIRE(topo.order().size() == 8);
+	for (int v = 0; v < g.V(); v++)
+	{
+		for (int w : g.adj(v))
+		{
+			REQUIRE(topo.level(v) < topo.level(w));
+		}
+	}
+
+	// 0 -> 1 -> 7 -> 5 -> 2 -> 3 -> 6 is the longest chain
+	REQUIRE(topo.levels_count() == 7);
+	REQUIRE(std::vector<int>(topo.wave(0).begin(), topo.wave(0).end()) == std::vector<int>{0});
+	REQUIRE(std::vector<int>(topo.wave(1).begin(), topo.wave(1).end()) == std::vector<int>{1, 4});
+
+	CSRGraph cyclic = Algs4TinyDG();
+	TopologicalSort none(cyclic);
+	REQUIRE(!none.is_dag());
+	REQUIRE(none.level(2) == -1);
+
+	// The sort does not hold on to its graph
+	TopologicalSort loaded(GraphLoader::load_adjacency("../resources/tinyDG.txt", true));
+	REQUIRE(loaded.is_dag());
+	REQUIRE(static_cast<int>(loaded.order().size()) == 13);
+}
+
+TEST_CASE("Fast loader reads adjacency lists like operator>>", "[Loader]")
+{
+	for (std::string name : {"tinyDG.txt", "testDG.txt"})
+	{
+		CSRGraph expected(ReadGraph<Digraph>(name));
+		for (int threads : {1, 3})
+		{
+			CSRGraph g = GraphLoader::load_adjacency("../resources/" + name, true, threads);
+			REQUIRE(g.str() == expected.str());
+		}
+	}
+
+	Graph expected = ReadGraph<Graph>("mediumUG.txt");
+	Graph g;
+	GraphLoader::load("../resources/mediumUG.txt", g, 2);
+	REQUIRE(g.str() == expected.str());
+
+	Digraph d;
+	GraphLoader::load("../resources/tinyDG.txt", d);
+	REQUIRE(d.in_degree(4) == 2);
+	REQUIRE(d.E() == 15);
+}
+
+TEST_CASE("Fast loader reads algs4 edge lists", "[Loader]")
+{
+	CSRGraph g = GraphLoader::load_edge_list("../resources/tinyDGEdges.txt", true, 1);
+	REQUIRE(g.str() == Algs4TinyDG().str());
+	REQUIRE(TarjanSCC(GraphLoader::load_edge_list("../resources/tinyDGEdges.txt", true, 4)).count() == 5);
+
+	CSRGraph u = GraphLoader::load_edge_list("../resources/tinyDGEdges.txt", false);
+	REQUIRE(u.E() == 22);
+	REQUIRE(u.arcs() == 44);
+	REQUIRE(u.edge(2, 4));
+
+	REQUIRE_THROWS(GraphLoader::load_edge_list("../resources/missing.txt", true));
+
+	// Ids are range-checked before they are narrowed to int
+	const std::string path = (std::filesystem::temp_directory_path() / "alg_tester2_loader.txt").string();
+	auto load = [&](const std::string &text, bool edges)
+	{
+		std::ofstream(path) << text;
+		return edges ? GraphLoader::load_edge_list(path, true) : GraphLoader::load_adjacency(path, true);
+	};
+
+	REQUIRE(load("3\n0: 1 2\n", false).edge(0, 2));
+	REQUIRE_THROWS(load("3\n0: 4294967297 2147483648\n", false));
+	REQUIRE_THROWS(load("3\n0: 1 99999999999999999999999\n", false));
+	REQUIRE_THROWS(load("3\n4294967296: 1\n", false));
+	REQUIRE_THROWS(load("4294967296\n0: 1\n", false));
+	REQUIRE_THROWS(load("3\n1\n0 4294967298\n", true));
+	REQUIRE_THROWS(load("3\n1\n18446744073709551617 1\n", true));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary graph files load as mapped views", "[Binary]")
+{
+	const std::filesystem::path dir = std::filesystem::temp_directory_path();
+	const std::string tiny = (dir / "alg_tester2_tinyDG.bin").string();
+	const std::string medium = (dir / "alg_tester2_mediumUG.bin").string();
+
+	Digraph g = ReadGraph<Digraph>("tinyDG.txt");
+	g.save_binary(tiny);
+	CSRGraph view = CSRGraph::load_binary(tiny);
+
+	REQUIRE(view.is_view());
+	REQUIRE(view.is_directed());
+	REQUIRE(view.str() == g.str());
+	REQUIRE(view.in_degrees()[4] == g.in_degree(4));
+
+	// Copies share the mapping; transposes own their arrays
+	CSRGraph copy = view;
+	REQUIRE(copy.is_view());
+	REQUIRE(copy.str() == view.str());
+	REQUIRE(!view.transpose().is_view());
+
+	Graph u = ReadGraph<Graph>("mediumUG.txt");
+	u.save_binary(medium);
+	CSRGraph uview = CSRGraph::load_binary(medium);
+	REQUIRE(!uview.is_directed());
+	REQUIRE(uview.E() == u.E());
+	REQUIRE(uview.str() == u.str());
+
+	REQUIRE_THROWS(CSRGraph::load_binary("../resources/tinyDG.txt"));
+
+	// Corrupt files are rejected instead of mapped
+	const std::string bad = (dir / "alg_tester2_corrupt.bin").string();
+	auto corrupt = [&](std::vector<long long> offsets, std::vector<int> targets, long long targets_at = -1, long long E = -1)
+	{
+		BinaryGraphHeader header{};
+		std::memcpy(header.magic, BinaryGraphHeader::MAGIC, sizeof(header.magic));
+		header.version = BinaryGraphHeader::VERSION;
+		header.flags = BinaryGraphHeader::DIRECTED;
+		header.V = static_cast<long long>(offsets.size()) - 1;
+		header.arcs = static_cast<long long>(targets.size());
+		header.E = E != -1 ? E : header.arcs;
+		header.offsets_at = sizeof(header);
+		header.targets_at = targets_at != -1 ? targets_at : header.offsets_at + 8 * static_cast<long long>(offsets.size());
+		std::ofstream out(bad, std::ios::binary);
+		out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char *>(offsets.data()), 8 * offsets.size());
+		out.write(reinterpret_cast<const char *>(targets.data()), 4 * targets.size());
+	};
+
+	corrupt({0, 1, 2}, {1, 0});
+	REQUIRE(CSRGraph::load_binary(bad, true).edge(1, 0));
+	corrupt({0, 1, 2}, {1, 0}, -8);
+	REQUIRE_THROWS(CSRGraph::load_binary(bad));
+	corrupt({0, 1, 2}, {1, 0}, 0x4000000000000000LL);
+	REQUIRE_THROWS(CSRGraph::load_binary(bad));
+	corrupt({0, 1, 3}, {1, 0});
+	REQUIRE_THROWS(CSRGraph::load_binary(bad));
+	corrupt({0, 1, 2}, {1, 0}, -1, 1);
+	REQUIRE_THROWS(CSRGraph::load_binary(bad));
+
+	// Bad contents inside valid sections are only found by the full scan
+	for (auto [offsets, targets] : std::vector<std::pair<std::vector<long long>, std::vector<int>>>{
+			 {{0, 1000000, 2}, {1, 99999}}, {{0, 2, 1, 2}, {1, 2}}, {{0, 1, 2}, {1, 2}}, {{0, 1, 2}, {1, -1}}})
+	{
+		corrupt(offsets, targets);
+		CSRGraph trusted = CSRGraph::load_binary(bad);
+		REQUIRE_THROWS(trusted.validate());
+		REQUIRE_THROWS(CSRGraph::load_binary(bad, true));
+	}
+
+	std::filesystem::remove(tiny);
+	std::filesystem::remove(medium);
+	std::filesystem::remove(bad);
+}
+
+TEST_CASE("Compressed graph decodes the sorted adjacency lists", "[Compressed]")
+{
+	Graph g = ReadGraph<Graph>("mediumUG.txt");
+	CompressedGraph cg(g, 2);
+
+	REQUIRE(cg.V() == g.V());
+	REQUIRE(cg.E() == g.E());
+	REQUIRE(cg.bytes_per_edge() < 4.0);
+	for (int v = 0; v < g.V(); v++)
+	{
+		std::list<int> expected = g.adj(v);
+		expected.sort();
+		std::vector<int> decoded;
+		for (int w : cg.adj(v))
+		{
+			decoded.push_back(w);
+		}
+
+		REQUIRE(std::vector<int>(expected.begin(), expected.end()) == decoded);
+		REQUIRE(cg.degree(v) == g.degree(v));
+	}
+
+	REQUIRE(cg.edge(0, 15));
+	REQUIRE(!cg.edge(0, 16));
+	REQUIRE(CSRGraph(ReadGraph<Graph>("mediumUG.txt")).E() == cg.to_csr().E());
+
+	// Vertices far from their neighbors still round-trip
+	CSRGraph far = CSRGraph::from_edges(300000, {{299999, 0}, {299999, 150000}, {1, 299998}, {1, 1}}, true);
+	CompressedGraph cfar(far);
+	REQUIRE(std::vector<int>(cfar.adj(299999).begin(), cfar.adj(299999).end()) == std::vector<int>{0, 150000});
+	REQUIRE(std::vector<int>(cfar.adj(1).begin(), cfar.adj(1).end()) == std::vector<int>{1, 299998});
+
+	// The index takes about 4 bytes per vertex next to the lists
+	REQUIRE(cfar.bytes() < 300000 * (1 + 4) + 300000 / 64 * 8 + 64);
+	REQUIRE(cfar.degree(299999) == 2);
+	REQUIRE(cfar.degree(299998) == 0);
+}
+
+TEST_CASE("Hybrid graph promotes hubs and matches a reference", "[Hybrid]")
+{
+	for (AdjacencyMode mode : {AdjacencyMode::Hybrid, AdjacencyMode::DenseBitmap})
+	{
+		HybridGraph g(200, false, mode, 8);
+		std::set<std::pair<int, int>> reference;
+		std::mt19937 rng(11);
+		std::uniform_int_distribution<int> hub(0, 3), any(0, 199);
+		for (int i = 0; i < 20000; i++)
+		{
+			int v = hub(rng), w = any(rng);
+			std::pair<int, int> e = {std::min(v, w), std::max(v, w)};
+			if (rng() % 3 == 0)
+			{
+				REQUIRE(g.remove_edge(v, w) == (reference.erase(e) == 1));
+			}
+			else
+			{
+				REQUIRE(g.add_edge(v, w) == reference.insert(e).second);
+			}
+		}
+
+		REQUIRE(g.E() == static_cast<long long>(reference.size()));
+		for (int v = 0; v < 200; v++)
+		{
+			std::vector<int> list = g.adj(v);
+			REQUIRE(static_cast<int>(list.size()) == g.degree(v));
+			for (int w : list)
+			{
+				REQUIRE(reference.count({std::min(v, w), std::max(v, w)}) == 1);
+				REQUIRE(g.edge(w, v));
+			}
+		}
+
+		if (mode == AdjacencyMode::Hybrid)
+		{
+			REQUIRE(g.is_hub(0));
+			REQUIRE(!g.is_hub(150));
+		}
+	}
+
+	CSRGraph tiny(ReadGraph<Digraph>("tinyDG.txt"));
+	HybridGraph d(tiny, AdjacencyMode::Hybrid, 2);
+	REQUIRE(d.E() == tiny.E());
+	REQUIRE(d.is_hub(0));
+	REQUIRE(d.edge(0, 6));
+	REQUIRE(!d.edge(6, 0));
+	REQUIRE(d.remove_edge(0, 6));
+	REQUIRE(!d.remove_edge(0, 6));
+
+	// Too many vertices for a matrix: the graph stays hybrid
+	HybridGraph huge(HybridGraph::MAX_DENSE_VERTICES + 1, true, AdjacencyMode::DenseBitmap);
+	REQUIRE(huge.mode() == AdjacencyMode::Hybrid);
+	REQUIRE(huge.add_edge(0, HybridGraph::MAX_DENSE_VERTICES));
+	REQUIRE(huge.edge(0, HybridGraph::MAX_DENSE_VERTICES));
+	REQUIRE(HybridGraph(200, false, AdjacencyMode::DenseBitmap).mode() == AdjacencyMode::DenseBitmap);
+}
+
+TEST_CASE("Graph::remove_edge removes both directions", "[Graph]")
+{
+	Graph g(4);
+	g.add_edge(0, 1);
+	g.add_edge(1, 2);
+	g.remove_edge(1, 0);
+
+	REQUIRE(g.E() == 1);
+	REQUIRE(!g.edge(0, 1));
+	REQUIRE(!g.edge(1, 0));
+	REQUIRE(g.edge(2, 1));
+}
+
+TEST_CASE("Dynamic graph applies streamed and batched updates", "[Dynamic]")
+{
+	for (bool directed : {false, true})
+	{
+		DynamicGraph g(50, directed);
+		std::set<std::pair<int, int>> reference;
+		auto canonical = [directed](int v, int w)
+		{
+			return directed ? std::make_pair(v, w) : std::make_pair(std::min(v, w), std::max(v, w));
+		};
+
+		std::mt19937 rng(5);
+		std::uniform_int_distribution<int> any(0, 49);
+		for (int round = 0; round < 50; round++)
+		{
+			std::vector<std::pair<int, int>> inserts, deletes;
+			for (int i = 0; i < 40; i++)
+			{
+				int v = any(rng), w = any(rng);
+				if (rng() % 2)
+				{
+					REQUIRE(g.add_edge(v, w) == reference.insert(canonical(v, w)).second);
+				}
+				else
+				{
+					inserts.push_back({v, w});
+					deletes.push_back({any(rng), any(rng)});
+				}
+			}
+
+			long long expected = 0;
+			for (auto [v, w] : deletes)
+			{
+				expected += reference.erase(canonical(v, w));
+			}
+			for (auto [v, w] : inserts)
+			{
+				expected += reference.insert(canonical(v, w)).second;
+			}
+
+			REQUIRE(g.apply_batch(inserts, deletes) == expected);
+			REQUIRE(g.E() == static_cast<long long>(reference.size()));
+		}
+
+		for (int v = 0; v < 50; v++)
+		{
+			for (int w : g.adj(v))
+			{
+				REQUIRE(reference.count(canonical(v, w)) == 1);
+			}
+		}
+		for (auto [v, w] : reference)
+		{
+			REQUIRE(g.edge(v, w));
+			REQUIRE(g.remove_edge(v, w));
+		}
+		REQUIRE(g.E() == 0);
+		REQUIRE(g.to_csr().arcs() == 0);
+	}
+
+	DynamicGraph g(3);
+	REQUIRE_THROWS(g.apply_batch({{0, 1}, {1, 3}}, {}));
+	REQUIRE(g.E() == 0);
+}
+
+TEST_CASE("Connected graph tracks components through inserts and deletes", "[Connectivity]")
+{
+	Graph base = ReadGraph<Graph>("mediumUG.txt");
+	ConnectedGraph g(base);
+	REQUIRE(g.components_count() == DepthFirstSearch(base).components_count());
+
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> any(0, g.V() - 1);
+	for (int i = 0; i < 300; i++)
+	{
+		int v = any(rng);
+		std::list<int> neighbors = g.adj(v);
+		if (!neighbors.empty() && rng() % 4 != 0)
+		{
+			g.remove_edge(v, neighbors.front());
+		}
+		else
+		{
+			g.add_edge(v, any(rng));
+		}
+
+		if (i % 25 == 0)
+		{
+			DepthFirstSearch dfs(g);
+			REQUIRE(g.components_count() == dfs.components_count());
+			for (int j = 0; j < 50; j++)
+			{
+				int a = any(rng), b = any(rng);
+				REQUIRE(g.connected(a, b) == (dfs.component(a) == dfs.component(b)));
+			}
+		}
+	}
+
+	ConnectedGraph path(3);
+	path.add_edge(0, 1);
+	path.add_edge(1, 2);
+	REQUIRE(path.connected(0, 2));
+	path.remove_edge(1, 2);
+	REQUIRE(!path.connected(0, 2));
+	REQUIRE(path.components_count() == 2);
+	REQUIRE_THROWS(path.add_edge(0, 3));
+
+	// Every split uses up a label; more than V of them force a compaction
+	ConnectedGraph chain(6);
+	for (int round = 0; round < 5; round++)
+	{
+		for (int v = 0; v + 1 < 6; v++)
+		{
+			chain.add_edge(v, v + 1);
+		}
+		REQUIRE(chain.components_count() == 1);
+		for (int v = 0; v + 1 < 6; v++)
+		{
+			chain.remove_edge(v, v + 1);
+			REQUIRE(chain.components_count() == v + 2);
+			REQUIRE(!chain.connected(v, v + 1));
+			REQUIRE((v + 2 == 6 || chain.connected(v + 1, 5)));
+		}
+	}
+
+	// Bulk loads bypass add_edge but still keep the union-find in sync
+	Graph tiny = ReadGraph<Graph>("tinyUG.txt");
+	const int tiny_components = DepthFirstSearch(tiny).components_count();
+	ConnectedGraph read(14);
+	std::ifstream in("../resources/tinyUG.txt");
+	in >> read;
+	REQUIRE(read.edge(0, 5));
+	REQUIRE(read.connected(0, 5));
+	REQUIRE(read.components_count() == tiny_components);
+
+	ConnectedGraph loaded(0);
+	GraphLoader::load("../resources/tinyUG.txt", loaded);
+	REQUIRE(loaded.connected(0, 4));
+	REQUIRE(!loaded.connected(0, 7));
+	REQUIRE(loaded.components_count() == tiny_components);
+
+	ConnectedGraph assigned(0);
+	static_cast<BaseGraph &>(assigned) = tiny;
+	REQUIRE(assigned.connected(9, 12));
+	REQUIRE(assigned.components_count() == tiny_components);
+	assigned.remove_edge(9, 12);
+	REQUIRE(assigned.connected(9, 12));
+}
+
+TEST_CASE("Multi-source BFS and the 2-hop index agree with DFS", "[Reachability]")
+{
+	CSRGraph g = RandomDigraph(400, 520, 9);
+	Digraph d(g.V());
+	for (int v = 0; v < g.V(); v++)
+	{
+		for (int w : g.adj(v))
+		{
+			d.add_edge(v, w);
+		}
+	}
+
+	std::vector<int> sources;
+	for (int s = 0; s < 300; s++)
+	{
+		sources.push_back((s * 7) % g.V());
+	}
+
+	MultiSourceBFS bfs(g, sources, 3);
+	ReachabilityIndex index(g);
+	for (int i = 0; i < bfs.sources_count(); i++)
+	{
+		DepthFirstSearch dfs(d, sources[i]);
+		for (int v = 0; v < g.V(); v++)
+		{
+			REQUIRE(bfs.reachable(i, v) == dfs.reachable(v));
+			REQUIRE(index.reachable(sources[i], v) == dfs.reachable(v));
+		}
+	}
+
+	// Queries are bounds-checked and do not need the graph any more
+	MultiSourceBFS detached(Algs4TinyDG(), {0, 7});
+	REQUIRE(detached.reachable(0, 4));
+	REQUIRE(!detached.reachable(0, 7));
+	REQUIRE(detached.reachable(1, 1));
+	REQUIRE_THROWS(detached.reachable(2, 0));
+	REQUIRE_THROWS(detached.reachable(-1, 0));
+	REQUIRE_THROWS(detached.reachable(0, 13));
+	REQUIRE_THROWS(detached.reachable(0, -1));
+
+	ReachabilityIndex tiny(Algs4TinyDG());
+	REQUIRE(tiny.reachable(0, 4));
+	REQUIRE(tiny.reachable(7, 1));
+	REQUIRE(!tiny.reachable(1, 0));
+	REQUIRE(!tiny.reachable(9, 6));
+	REQUIRE_THROWS(tiny.reachable(-1, 0));
+	REQUIRE_THROWS(tiny.reachable(0, 13));
+}
+
+TEST_CASE("Vertex reorderings are permutations that preserve the graph", "[Reorder]")
+{
+	// A 30 x 30 grid with shuffled vertex numbers
+	const int side = 30;
+	std::vector<int> shuffle(side * side);
+	std::iota(shuffle.begin(), shuffle.end(), 0);
+	std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937(5));
+	std::vector<std::pair<int, int>> edges;
+	for (int r = 0; r < side; r++)
+	{
+		for (int c = 0; c < side; c++)
+		{
+			if (c + 1 < side)
+			{
+				edges.push_back({shuffle[r * side + c], shuffle[r * side + c + 1]});
+			}
+			if (r + 1 < side)
+			{
+				edges.push_back({shuffle[r * side + c], shuffle[(r + 1) * side + c]});
+			}
+		}
+	}
+	CSRGraph grid = CSRGraph::from_edges(side * side, edges, false);
+
+	auto bandwidth = [](const CSRGraph &g)
+	{
+		int b = 0;
+		for (int v = 0; v < g.V(); v++)
+		{
+			for (int w : g.adj(v))
+			{
+				b = std::max(b, std::abs(v - w));
+			}
+		}
+		return b;
+	};
+
+	std::vector<int> rcm = VertexOrdering::reverse_cuthill_mckee(grid);
+	CSRGraph banded = VertexOrdering::relabel(grid, rcm, 2);
+	REQUIRE(banded.E() == grid.E());
+	REQUIRE(bandwidth(banded) <= 2 * side);
+	REQUIRE(bandwidth(banded) < bandwidth(grid));
+	for (int v = 0; v < grid.V(); v++)
+	{
+		for (int w : grid.adj(v))
+		{
+			REQUIRE(banded.edge(rcm[v], rcm[w]));
+		}
+	}
+
+	CSRGraph g = RandomDigraph(300, 900, 4);
+	for (const std::vector<int> &perm : {VertexOrdering::degree_sort(g), VertexOrdering::bfs_order(g),
+										 VertexOrdering::reverse_cuthill_mckee(g)})
+	{
+		std::vector<int> inv = VertexOrdering::inverse(perm);
+		CSRGraph h = VertexOrdering::relabel(g, perm);
+		REQUIRE(h.is_directed());
+		REQUIRE(h.arcs() == g.arcs());
+
+		std::vector<int> degrees(h.V());
+		for (int v = 0; v < h.V(); v++)
+		{
+			degrees[v] = h.degree(v);
+			REQUIRE(inv[perm[v]] == v);
+		}
+		std::vector<int> original = VertexOrdering::to_original(degrees, perm);
+		for (int v = 0; v < g.V(); v++)
+		{
+			REQUIRE(original[v] == g.degree(v));
+		}
+	}
+
+	std::vector<int> hubs = VertexOrdering::degree_sort(grid);
+	REQUIRE(grid.degree(VertexOrdering::inverse(hubs)[0]) == 4);
+	REQUIRE_THROWS(VertexOrdering::inverse({0, 0, 1}));
+}
+
+TEST_CASE("Dijkstra and delta-stepping agree with Bellman-Ford", "[ShortestPaths]")
+{
+	std::mt19937 rng(17);
+	std::uniform_int_distribution<int> vertex(0, 499);
+	std::uniform_int_distribution<long long> weight(0, 1000);
+	std::vector<WeightedEdge> edges;
+	for (int i = 0; i < 2500; i++)
+	{
+		edges.push_back({vertex(rng), vertex(rng), weight(rng)});
+	}
+
+	for (bool directed : {true, false})
+	{
+		EdgeWeightedGraph g(500, edges, directed);
+		REQUIRE(g.E() == 2500);
+		REQUIRE(g.edges().size() == edges.size());
+
+		std::vector<long long> expected(g.V(), ShortestPaths::INFINITY_DIST);
+		expected[0] = 0;
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (const WeightedEdge &e : edges)
+			{
+				for (auto [v, w] : {std::pair<int, int>{e.v, e.w}, std::pair<int, int>{e.w, e.v}})
+				{
+					if (expected[v] != ShortestPaths::INFINITY_DIST && expected[v] + e.weight < expected[w])
+					{
+						expected[w] = expected[v] + e.weight;
+						changed = true;
+					}
+					if (directed)
+					{
+						break;
+					}
+				}
+			}
+		}
+
+		DijkstraSP four(g, 0);
+		DijkstraSP radix(g, 0, DijkstraHeap::Radix);
+		DeltaSteppingSP stepping(g, 0, 0, 3);
+		DeltaSteppingSP narrow(g, 0, 7, 2);
+		for (const ShortestPaths *sp : std::vector<const ShortestPaths *>{&four, &radix, &stepping, &narrow})
+		{
+			REQUIRE(sp->distances() == expected);
+			for (int v = 0; v < g.V(); v++)
+			{
+				std::stack<int> path = sp->path_to(v);
+				REQUIRE(path.empty() == !sp->has_path_to(v));
+				if (path.empty())
+				{
+					continue;
+				}
+
+				REQUIRE(path.top() == 0);
+				long long length = 0;
+				for (int x = path.top(); path.pop(), !path.empty(); x = path.top())
+				{
+					long long best = ShortestPaths::INFINITY_DIST;
+					auto targets = g.adj(x);
+					auto weights = g.weights(x);
+					for (std::size_t k = 0; k < targets.size(); k++)
+					{
+						if (targets[k] == path.top())
+						{
+							best = std::min(best, weights[k]);
+						}
+					}
+					REQUIRE(best != ShortestPaths::INFINITY_DIST);
+					length += best;
+				}
+				REQUIRE(length == sp->dist_to(v));
+			}
+		}
+	}
+
+	std::istringstream in("4\n3\n0 1 5\n1 2 0\n2 3 7\n");
+	EdgeWeightedGraph chain = EdgeWeightedGraph::read(in, false);
+	REQUIRE(chain.str() == "4\n3\n0 1 5\n1 2 0\n2 3 7\n");
+	REQUIRE(DijkstraSP(chain, 3).dist_to(0) == 12);
+	REQUIRE_THROWS(EdgeWeightedGraph(2, {{0, 1, -1}}, true));
+
+	// Weights far above the bucket width wrap around the capped buckets
+	std::vector<WeightedEdge> far = {{0, 1, 3000000000000LL}, {1, 2, 1}, {0, 2, 5000000000000LL}, {2, 3, 70000}};
+	EdgeWeightedGraph sparse(5, far, true);
+	DeltaSteppingSP wide(sparse, 0, 1, 2);
+	REQUIRE(wide.distances() == DijkstraSP(sparse, 0).distances());
+	REQUIRE(wide.dist_to(3) == 3000000070001LL);
+	REQUIRE(!wide.has_path_to(4));
+
+	// The algs4 tinyEWD.txt file, with real weights
+	std::istringstream ewd("8\n15\n4 5 0.35\n5 4 0.35\n4 7 0.37\n5 7 0.28\n7 5 0.28\n5 1 0.32\n0 4 0.38\n0 2 0.26\n"
+						   "7 3 0.39\n1 3 0.29\n2 7 0.34\n6 2 0.40\n3 6 0.52\n6 0 0.58\n6 4 0.93\n");
+	RealEdgeWeightedGraph tiny = RealEdgeWeightedGraph::read(ewd, true);
+	const std::vector<double> tiny_dist = {0, 1.05, 0.26, 0.99, 0.38, 0.73, 1.51, 0.60};
+	RealDijkstraSP real_dijkstra(tiny, 0);
+	RealDeltaSteppingSP real_stepping(tiny, 0, 0.1, 2);
+	for (int v = 0; v < tiny.V(); v++)
+	{
+		REQUIRE(std::abs(real_dijkstra.dist_to(v) - tiny_dist[v]) < 1e-9);
+		REQUIRE(std::abs(real_stepping.dist_to(v) - tiny_dist[v]) < 1e-9);
+	}
+	REQUIRE(real_dijkstra.path_to(6).size() == 5);
+	REQUIRE_THROWS(RealDijkstraSP(tiny, 0, DijkstraHeap::Radix));
+
+	std::istringstream real_weights("2\n1\n0 1 0.16\n");
+	REQUIRE_THROWS(EdgeWeightedGraph::read(real_weights, false));
+}
+
+TEST_CASE("Kruskal and Boruvka build the same minimum spanning forest", "[MST]")
+{
+	for (long long max_weight : {20LL, 1000000000000LL})
+	{
+		// Two dense halves joined by a few edges, plus isolated vertices
+		std::mt19937 rng(23);
+		std::uniform_int_distribution<int> half(0, 199);
+		std::uniform_int_distribution<long long> weight(0, max_weight);
+		std::vector<WeightedEdge> edges;
+		for (int i = 0; i < 3000; i++)
+		{
+			int offset = i % 2 ? 200 : 0;
+			edges.push_back({offset + half(rng), offset + half(rng), weight(rng)});
+		}
+		edges.push_back({5, 305, weight(rng)});
+		edges.push_back({17, 217, weight(rng)});
+		EdgeWeightedGraph g(410, edges, false);
+
+		// Reference: Kruskal over a comparison sort with the same tie-breaking
+		std::vector<WeightedEdge> sorted = g.edges();
+		std::stable_sort(sorted.begin(), sorted.end(), [](const WeightedEdge &a, const WeightedEdge &b)
+						 { return a.weight < b.weight; });
+		PCWQuickUF uf(g.V());
+		long long expected = 0;
+		std::vector<WeightedEdge> forest;
+		for (const WeightedEdge &e : sorted)
+		{
+			if (uf._union(e.v, e.w))
+			{
+				expected += e.weight;
+				forest.push_back(e);
+			}
+		}
+
+		auto as_set = [](const std::vector<WeightedEdge> &list)
+		{
+			std::set<std::tuple<int, int, long long>> s;
+			for (const WeightedEdge &e : list)
+			{
+				s.insert({std::min(e.v, e.w), std::max(e.v, e.w), e.weight});
+			}
+			return s;
+		};
+
+		KruskalMST kruskal(g, 2);
+		BoruvkaMST boruvka(g, 3);
+		REQUIRE(uf.components_count() == 11);
+		REQUIRE(kruskal.edges().size() == 399);
+		REQUIRE(kruskal.weight() == expected);
+		REQUIRE(boruvka.weight() == expected);
+		REQUIRE(as_set(kruskal.edges()) == as_set(forest));
+		REQUIRE(as_set(boruvka.edges()) == as_set(forest));
+		REQUIRE(boruvka.rounds() <= 9);
+	}
+
+	// Large enough for the joining and relabeling passes to run in parallel
+	std::mt19937 rng(29);
+	std::uniform_int_distribution<int> vertex(0, 19999);
+	std::uniform_int_distribution<long long> weight(0, 50);
+	std::vector<WeightedEdge> edges;
+	for (int i = 0; i < 60000; i++)
+	{
+		edges.push_back({vertex(rng), vertex(rng), weight(rng)});
+	}
+	EdgeWeightedGraph large(20000, edges, false);
+	BoruvkaMST parallel(large, 4);
+	REQUIRE(parallel.weight() == KruskalMST(large, 4).weight());
+	REQUIRE(parallel.edges() == BoruvkaMST(large, 3).edges());
+
+	EdgeWeightedGraph directed(2, {{0, 1, 1}}, true);
+	REQUIRE_THROWS(KruskalMST(directed));
+}
+
+TEST_CASE("Triangle counting matches a brute-force count", "[Triangles]")
+{
+	std::mt19937 rng(31);
+	std::uniform_int_distribution<int> vertex(0, 149);
+	Graph g(150);
+	for (int i = 0; i < 1800; i++)
+	{
+		g.add_edge(vertex(rng), vertex(rng)); // Keeps parallel edges and self-loops
+	}
+	for (int w = 1; w < 150; w++)
+	{
+		g.add_edge(0, w); // A hub, so some intersections gallop
+	}
+
+	std::vector<std::vector<bool>> adjacent(150, std::vector<bool>(150, false));
+	for (int v = 0; v < 150; v++)
+	{
+		for (int w : g.adj(v))
+		{
+			adjacent[v][w] = v != w;
+		}
+	}
+
+	long long expected = 0;
+	std::vector<long long> at(150, 0);
+	for (int a = 0; a < 150; a++)
+	{
+		for (int b = a + 1; b < 150; b++)
+		{
+			for (int c = b + 1; c < 150 && adjacent[a][b]; c++)
+			{
+				if (adjacent[a][c] && adjacent[b][c])
+				{
+					expected++;
+					at[a]++;
+					at[b]++;
+					at[c]++;
+				}
+			}
+		}
+	}
+
+	TriangleCounting tc(g, 3);
+	REQUIRE(tc.count() == expected);
+	for (int v = 0; v < 150; v++)
+	{
+		REQUIRE(tc.triangles(v) == at[v]);
+		int d = 0;
+		for (int w = 0; w < 150; w++)
+		{
+			d += adjacent[v][w];
+		}
+		double cc = d < 2 ? 0.0 : 2.0 * at[v] / (static_cast<double>(d) * (d - 1));
+		REQUIRE(std::abs(tc.clustering(v) - cc) < 1e-12);
+	}
+
+	std::vector<std::pair<int, int>> k5;
+	for (int v = 0; v < 5; v++)
+	{
+		for (int w = v + 1; w < 5; w++)
+		{
+			k5.push_back({v, w});
+		}
+	}
+	TriangleCounting complete(CSRGraph::from_edges(6, k5, false));
+	REQUIRE(complete.count() == 10);
+	REQUIRE(complete.clustering(3) == 1.0);
+	REQUIRE(complete.clustering(5) == 0.0);
+	REQUIRE(std::abs(complete.average_clustering() - 5.0 / 6) < 1e-12);
+
+	std::vector<int> evens, odds, range;
+	for (int x = 0; x < 2000; x++)
+	{
+		(x % 2 ? odds : evens).push_back(x);
+		if (x % 97 == 3 || x % 2 == 1)
+		{
+			range.push_back(x);
+		}
+	}
+	REQUIRE(TriangleCounting::intersection_size(evens, odds) == 0);
+	REQUIRE(TriangleCounting::intersection_size(evens, range) == 10);
+	REQUIRE(TriangleCounting::intersection_size(std::vector<int>{3, 1001, 1999}, evens) == 0);
+	REQUIRE(TriangleCounting::intersection_size(std::vector<int>{3, 1001, 1999}, odds) == 3);
+}
+
+TEST_CASE("PageRank matches a dense power iteration", "[PageRank]")
+{
+	CSRGraph g = RandomDigraph(200, 700, 13);
+	const int V = g.V();
+	const double d = 0.85;
+
+	// Dense reference with dangling mass spread like the teleport jumps
+	auto reference = [&](const std::vector<double> &teleport)
+	{
+		std::vector<double> rank = teleport, next(V);
+		for (int it = 0; it < 500; it++)
+		{
+			double dangling = 0;
+			std::fill(next.begin(), next.end(), 0.0);
+			for (int u = 0; u < V; u++)
+			{
+				if (g.degree(u) == 0)
+				{
+					dangling += rank[u];
+				}
+				for (int w : g.adj(u))
+				{
+					next[w] += d * rank[u] / g.degree(u);
+				}
+			}
+			for (int v = 0; v < V; v++)
+			{
+				next[v] += (1 - d + d * dangling) * teleport[v];
+			}
+			rank.swap(next);
+		}
+		return rank;
+	};
+
+	PageRankOptions options;
+	options.tolerance = 1e-12;
+	options.max_iterations = 1000;
+	options.threads = 3;
+	PageRank<double> pr(g, options);
+	std::vector<double> expected = reference(std::vector<double>(V, 1.0 / V));
+	REQUIRE(pr.converged());
+	double total = 0;
+	for (int v = 0; v < V; v++)
+	{
+		REQUIRE(std::abs(pr.rank(v) - expected[v]) < 1e-9);
+		total += pr.rank(v);
+	}
+	REQUIRE(std::abs(total - 1) < 1e-9);
+
+	Digraph digraph(V);
+	for (int v = 0; v < V; v++)
+	{
+		for (int w : g.adj(v))
+		{
+			digraph.add_edge(v, w);
+		}
+	}
+	options.tolerance = 1e-5;
+	PageRank<float> single(digraph, options);
+	for (int v = 0; v < V; v++)
+	{
+		REQUIRE(std::abs(single.rank(v) - expected[v]) < 1e-4);
+	}
+
+	std::vector<double> personal(V, 0.0);
+	personal[0] = 3;
+	personal[1] = 1;
+	pr.run(personal);
+	std::vector<double> teleport(V, 0.0);
+	teleport[0] = 0.75;
+	teleport[1] = 0.25;
+	expected = reference(teleport);
+	for (int v = 0; v < V; v++)
+	{
+		REQUIRE(std::abs(pr.rank(v) - expected[v]) < 1e-9);
+	}
+
+	REQUIRE_THROWS(pr.run(std::vector<double>(V, 0.0)));
+	REQUIRE_THROWS(pr.run({1.0}));
+}
+
+TEST_CASE("Generators are seeded and independent of the thread count", "[Generators]")
+{
+	GeneratedGraph rmat = GraphGenerator::rmat(12, 200000, 42, true, 1);
+	REQUIRE(rmat.V == 4096);
+	REQUIRE(rmat.edges.size() == 200000);
+	REQUIRE(GraphGenerator::rmat(12, 200000, 42, true, 4).edges == rmat.edges);
+	REQUIRE(GraphGenerator::rmat(12, 200000, 43, true, 4).edges != rmat.edges);
+
+	// Skewed: the busiest vertex has far more than the average degree
+	CSRGraph skewed = rmat.to_csr();
+	int max_degree = 0;
+	for (int v = 0; v < skewed.V(); v++)
+	{
+		max_degree = std::max(max_degree, skewed.degree(v));
+	}
+	REQUIRE(max_degree > 20 * 200000 / 4096);
+
+	GeneratedGraph gnp = GraphGenerator::gnp(3000, 0.01, 7, false, 1);
+	REQUIRE(GraphGenerator::gnp(3000, 0.01, 7, false, 3).edges == gnp.edges);
+	double expected = 0.01 * 3000 * 2999 / 2;
+	REQUIRE(std::abs(gnp.edges.size() - expected) < 5 * std::sqrt(expected));
+	std::set<std::pair<int, int>> distinct(gnp.edges.begin(), gnp.edges.end());
+	REQUIRE(distinct.size() == gnp.edges.size());
+	for (auto [v, w] : gnp.edges)
+	{
+		REQUIRE(v < w);
+	}
+	REQUIRE(GraphGenerator::gnp(20, 1.0, 1, true).edges.size() == 380);
+
+	// Skips beyond the long long range end the row instead of wrapping
+	for (bool directed : {true, false})
+	{
+		GeneratedGraph sparse = GraphGenerator::gnp(1000, 1e-20, 1, directed, 1);
+		REQUIRE(sparse.edges.size() <= 1);
+		for (auto [v, w] : sparse.edges)
+		{
+			REQUIRE((v >= 0 && v < 1000 && w >= 0 && w < 1000));
+		}
+	}
+
+	GeneratedGraph gnm = GraphGenerator::gnm(100, 4000, 9, true, 2);
+	REQUIRE(gnm.edges.size() == 4000);
+	REQUIRE(GraphGenerator::gnm(100, 4000, 9, true, 1).edges == gnm.edges);
+	REQUIRE(std::set<std::pair<int, int>>(gnm.edges.begin(), gnm.edges.end()).size() == 4000);
+	REQUIRE_THROWS(GraphGenerator::gnm(10, 46, 1));
+
+	// Deduplicated by a parallel sort that matches the serial one
+	GeneratedGraph large = GraphGenerator::gnm(3000, 2000000, 4, false, 4);
+	REQUIRE(large.edges.size() == 2000000);
+	REQUIRE(std::adjacent_find(large.edges.begin(), large.edges.end(), std::greater_equal<>()) == large.edges.end());
+	REQUIRE(GraphGenerator::gnm(3000, 2000000, 4, false, 1).edges == large.edges);
+
+	Graph grid;
+	GraphGenerator::grid(4, 5, false, 2).fill(grid);
+	REQUIRE(grid.V() == 20);
+	REQUIRE(grid.E() == 31);
+	REQUIRE(grid.degree(0) == 2);
+	REQUIRE(grid.degree(6) == 4);
+	REQUIRE(grid.edge(13, 18));
+
+	Digraph chain;
+	GraphGenerator::chain(5000, true).fill(chain);
+	REQUIRE(chain.E() == 4999);
+	REQUIRE(chain.in_degree(4999) == 1);
+	REQUIRE(chain.out_degree(4999) == 0);
+	Graph wrong;
+	REQUIRE_THROWS(GraphGenerator::chain(3, true).fill(wrong));
+}
+
+TEST_CASE("Arena adjacency keeps list semantics through edits and copies", "[Graph]")
+{
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> vertex(0, 49);
+	Digraph g(50);
+	std::vector<std::list<int>> expected(50);
+	for (int step = 0; step < 20000; step++)
+	{
+		int v = vertex(rng), w = vertex(rng);
+		auto it = std::find(expected[v].begin(), expected[v].end(), w);
+		if (step % 3 == 2 && it != expected[v].end())
+		{
+			expected[v].erase(it);
+			g.remove_edge(v, w);
+		}
+		else
+		{
+			expected[v].push_back(w);
+			g.add_edge(v, w);
+		}
+	}
+
+	Digraph copy(g);
+	for (int v = 0; v < 50; v++)
+	{
+		REQUIRE(g.adj(v) == expected[v]);
+		REQUIRE(g.out_degree(v) == static_cast<int>(expected[v].size()));
+		REQUIRE(std::list<int>(copy.neighbors(v).begin(), copy.neighbors(v).end()) == expected[v]);
+	}
+
+	// The copy owns its pages
+	copy.add_edge(0, 1);
+	g.remove_edge(1, g.adj(1).front());
+	REQUIRE(copy.out_degree(0) == g.out_degree(0) + 1);
+	REQUIRE(copy.out_degree(1) == g.out_degree(1) + 1);
+	REQUIRE_THROWS(Graph(2).remove_edge(0, 1));
+
+	AdjacencyArena arena(3);
+	std::vector<int> big(5000);
+	std::iota(big.begin(), big.end(), 0);
+	arena.append(2, big);
+	arena.push_back(2, -1);
+	REQUIRE(arena.size(2) == 5001);
+	REQUIRE(arena.blocks_count() <= 3);
+	REQUIRE(arena.erase(2, 4999));
+	REQUIRE(!arena.contains(2, 4999));
+	REQUIRE(arena.contains(2, -1));
+	long long sum = 0;
+	arena.for_each(2, [&sum](int w)
+				   { sum += w; });
+	REQUIRE(sum == 4998LL * 4999 / 2 - 1);
+	REQUIRE(arena[0].begin() == arena[0].end());
+}
+
+TEST_CASE("Visitor traversal classifies edges on every graph type", "[Traversal]")
+{
+	// Only the hooks a visitor defines are called
+	struct Counter
+	{
+		int discovered = 0, finished = 0, trees = 0, backs = 0, others = 0;
+		std::vector<int> order;
+
+		void discover(int v)
+		{
+			discovered++;
+			order.push_back(v);
+		}
+		void finish(int) { finished++; }
+		void tree_edge(int, int) { trees++; }
+		void back_edge(int, int) { backs++; }
+		void forward_or_cross_edge(int, int) { others++; }
+	};
+
+	struct Roots
+	{
+		int count = 0;
+		void start(int) { count++; }
+	};
+
+	CSRGraph g = Algs4TinyDG();
+	Counter csr;
+	traverse(g, csr);
+	REQUIRE(csr.discovered == 13);
+	REQUIRE(csr.finished == 13);
+	REQUIRE(csr.trees + csr.backs + csr.others == 22);
+	REQUIRE(csr.trees == 13 - 3); // Roots 0, 2 and 6 (vertex order)
+	REQUIRE(csr.backs > 0);
+
+	Digraph d(g.V());
+	for (int v = 0; v < g.V(); v++)
+	{
+		for (int w : g.adj(v))
+		{
+			d.add_edge(v, w);
+		}
+	}
+	Counter list;
+	traverse(d, list);
+	REQUIRE(list.order == csr.order);
+
+	DepthFirstSearch dfs(d);
+	REQUIRE(std::vector<int>(dfs.in_preorder().begin(), dfs.in_preorder().end()) == csr.order);
+
+	CompressedGraph compressed(g);
+	Counter packed;
+	traverse(compressed, 7, packed);
+	REQUIRE(packed.discovered == 13);
+
+	// Undirected: a tree edge is not reported back as a back edge, but a
+	// parallel edge is
+	Graph cycle(4);
+	cycle.add_edge(0, 1);
+	cycle.add_edge(1, 2);
+	cycle.add_edge(2, 0);
+	cycle.add_edge(0, 1);
+	Counter undirected;
+	traverse(cycle, undirected);
+	REQUIRE(undirected.trees == 2);
+	REQUIRE(undirected.backs == 2);
+	REQUIRE(undirected.others == 0);
+
+	Roots roots;
+	traverse(cycle, roots);
+	REQUIRE(roots.count == 2);
+
+	// Early exit once 9 is found
+	struct Finder
+	{
+		int target, seen = 0;
+		bool found = false;
+		void discover(int v)
+		{
+			seen++;
+			found = found || v == target;
+		}
+		bool done() const { return found; }
+	} finder{9};
+	traverse(g, 0, finder);
+	REQUIRE(!finder.found);
+	traverse(g, 6, finder);
+	REQUIRE(finder.found);
+
+	// Deep graphs do not overflow the call stack
+	Digraph chain;
+	GraphGenerator::chain(1000000, true).fill(chain);
+	DepthFirstSearch deep(chain, 0);
+	REQUIRE(deep.reachable(999999));
+	REQUIRE(deep.path_to(999999).size() == 1000000);
+}
+
+TEST_CASE("Bidirectional BFS finds shortest paths like a plain BFS", "[BFS]")
+{
+	for (bool directed : {false, true})
+	{
+		CSRGraph g = GraphGenerator::gnm(600, directed ? 1500 : 700, 21, directed).to_csr();
+		BidirectionalBFS bibfs(g);
+		for (int s = 0; s < g.V(); s += 37)
+		{
+			std::vector<int> dist(g.V(), -1);
+			std::vector<int> queue = {s};
+			dist[s] = 0;
+			for (std::size_t i = 0; i < queue.size(); i++)
+			{
+				for (int w : g.adj(queue[i]))
+				{
+					if (dist[w] == -1)
+					{
+						dist[w] = dist[queue[i]] + 1;
+						queue.push_back(w);
+					}
+				}
+			}
+
+			for (int t = 0; t < g.V(); t++)
+			{
+				std::vector<int> path = bibfs.shortest_path(s, t);
+				REQUIRE(static_cast<int>(path.size()) - 1 == dist[t]);
+				if (!path.empty())
+				{
+					REQUIRE(path.front() == s);
+					REQUIRE(path.back() == t);
+					for (std::size_t i = 1; i < path.size(); i++)
+					{
+						REQUIRE(g.edge(path[i - 1], path[i]));
+					}
+				}
+			}
+		}
+	}
+
+	// Graph and Digraph snapshots, on buffers already sized by the queries above
+	Digraph d(5);
+	d.add_edge(0, 1);
+	d.add_edge(1, 2);
+	d.add_edge(2, 3);
+	d.add_edge(0, 3);
+	d.add_edge(3, 4);
+	BidirectionalBFS directed(d);
+	REQUIRE(directed.shortest_path(0, 4) == std::vector<int>{0, 3, 4});
+	REQUIRE(directed.distance(4, 0) == -1);
+	REQUIRE(directed.distance(2, 2) == 0);
+
+	Graph u(5);
+	u.add_edge(0, 1);
+	u.add_edge(1, 2);
+	u.add_edge(3, 4);
+	BidirectionalBFS undirected(u);
+	REQUIRE(undirected.distance(2, 0) == 2);
+	REQUIRE(undirected.shortest_path(0, 4).empty());
+	REQUIRE_THROWS(undirected.distance(0, 5));
+}
+
+TEST_CASE("Concurrent union-find agrees with the sequential one", "[UF]")
+{
+	std::ifstream in("../resources/mediumUF.txt");
+	REQUIRE(in);
+	int n, p, q;
+	in >> n;
+	std::vector<std::pair<int, int>> pairs;
+	while (in >> p >> q)
+	{
+		pairs.push_back({p, q});
+	}
+
+	PCWQuickUF reference(n);
+	for (auto [p, q] : pairs)
+	{
+		reference._union(p, q);
+	}
+	REQUIRE(reference.components_count() == 3);
+
+	for (int threads : {1, 4})
+	{
+		ConcurrentUF uf(n);
+		uf.union_all(pairs, threads);
+		REQUIRE(uf.components_count() == reference.components_count());
+		for (int v = 0; v < n; v++)
+		{
+			REQUIRE(uf.connected(v, (v * 31) % n) == reference.connected(v, (v * 31) % n));
+		}
+	}
+
+	// Unions racing with queries on a random stream
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<int> pick(0, 99999);
+	std::vector<std::pair<int, int>> stream(200000);
+	for (auto &e : stream)
+	{
+		e = {pick(rng), pick(rng)};
+	}
+
+	ConcurrentUF uf(100000);
+	PCWQuickUF sequential(100000);
+	parallel_run(4, [&](int tid)
+				 {
+		for (std::size_t i = tid; i < stream.size(); i += 4)
+		{
+			uf._union(stream[i].first, stream[i].second);
+			uf.connected(stream[i].second, stream[(i * 7) % stream.size()].first);
+		} });
+	for (auto [p, q] : stream)
+	{
+		sequential._union(p, q);
+	}
+	REQUIRE(uf.components_count() == sequential.components_count());
+	for (auto [p, q] : stream)
+	{
+		REQUIRE(uf.connected(p, q));
+		REQUIRE(uf._find(p) == uf._find(q));
+	}
+}
+
+TEST_CASE("Policy-based union-find matches the virtual classes", "[UF]")
+{
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> pick(0, 1999);
+	std::vector<std::pair<int, int>> stream(2500);
+	for (auto &e : stream)
+	{
+		e = {pick(rng), pick(rng)};
+	}
+
+	auto check = [&]<class Packed, class Virtual>(Packed packed, Virtual reference)
+	{
+		for (auto [p, q] : stream)
+		{
+			REQUIRE(packed._union(p, q) == reference._union(p, q));
+			REQUIRE(packed.components_count() == reference.components_count());
+		}
+		for (int v = 0; v < 2000; v++)
+		{
+			REQUIRE(packed.connected(v, (v * 13) % 2000) == reference.connected(v, (v * 13) % 2000));
+		}
+	};
+	check(PackedUF(2000), UF(2000));
+	check(PackedQuickUF(2000), QuickUF(2000));
+	check(PackedWeightedQuickUF(2000), WeightedQuickUF(2000));
+	check(PackedPCWQuickUF(2000), PCWQuickUF(2000));
+	check(UnionFind<LinkBySize, PathSplitting>(2000), PCWQuickUF(2000));
+	check(UnionFind<LinkBySize, FullCompression>(2000), PCWQuickUF(2000));
+	check(UnionFind<LinkByRank, PathHalving>(2000), PCWQuickUF(2000));
+	check(UnionFind<LinkByRank, FullCompression>(2000), PCWQuickUF(2000));
+	check(UnionFind<QuickUnionLink, PathSplitting>(2000), QuickUF(2000));
+
+	// Weighted trees come out the same, so do the roots
+	PackedWeightedQuickUF packed(2000);
+	WeightedQuickUF weighted(2000);
+	std::vector<int> size(2000, 0);
+	for (auto [p, q] : stream)
+	{
+		packed._union(p, q);
+		weighted._union(p, q);
+	}
+	for (int v = 0; v < 2000; v++)
+	{
+		REQUIRE(packed._find(v) == weighted._find(v));
+		size[weighted._find(v)]++;
+	}
+	for (int v = 0; v < 2000; v++)
+	{
+		REQUIRE(packed.size(v) == size[weighted._find(v)]);
+	}
+}
+
+TEST_CASE("Rollback union-find undoes unions back to a snapshot", "[UF]")
+{
+	RollbackUF uf(8);
+	uf._union(0, 1);
+	uf._union(2, 3);
+	std::size_t mark = uf.snapshot();
+	REQUIRE(uf._union(1, 3));
+	REQUIRE(!uf._union(0, 2));
+	REQUIRE(uf._union(4, 0));
+	REQUIRE(uf.components_count() == 4);
+	REQUIRE(uf.connected(4, 3));
+
+	uf.rollback(mark);
+	REQUIRE(uf.components_count() == 6);
+	REQUIRE(uf.connected(0, 1));
+	REQUIRE(uf.connected(2, 3));
+	REQUIRE(!uf.connected(1, 3));
+	REQUIRE(!uf.connected(4, 0));
+	uf.rollback(0);
+	REQUIRE(uf.components_count() == 8);
+
+	// Unions cannot reach the base class and skip the undo log
+	static_assert(!std::is_convertible_v<RollbackUF &, UnionFind<LinkByRank, NoCompression> &>);
+	std::vector<std::pair<int, int>> queries = {{0, 1}, {0, 0}};
+	REQUIRE(uf.connected_batch(queries) == std::vector<char>{0, 1});
+}
+
+TEST_CASE("Offline dynamic connectivity matches rebuilding at every query", "[Connectivity]")
+{
+	const int V = 60;
+	std::mt19937 rng(17);
+	std::uniform_int_distribution<int> pick(0, V - 1);
+	OfflineDynamicConnectivity timeline(V);
+	std::vector<std::pair<int, int>> edges; // Live multiset
+	std::vector<std::pair<bool, int>> expected;
+	for (int step = 0; step < 3000; step++)
+	{
+		int op = rng() % 3;
+		if (op == 0 || edges.empty())
+		{
+			int v = pick(rng), w = pick(rng);
+			timeline.add_edge(v, w);
+			edges.push_back({v, w});
+		}
+		else if (op == 1)
+		{
+			std::size_t i = rng() % edges.size();
+			auto [v, w] = edges[i];
+			if (rng() % 2)
+			{
+				std::swap(v, w);
+			}
+			timeline.remove_edge(v, w);
+			edges.erase(edges.begin() + i);
+		}
+		else
+		{
+			int v = pick(rng), w = pick(rng);
+			PCWQuickUF uf(V);
+			for (auto [a, b] : edges)
+			{
+				uf._union(a, b);
+			}
+			REQUIRE(timeline.query(v, w) == static_cast<int>(expected.size()));
+			expected.push_back({uf.connected(v, w), uf.components_count()});
+		}
+	}
+
+	timeline.solve();
+	REQUIRE(timeline.queries_count() == static_cast<int>(expected.size()));
+	for (int q = 0; q < timeline.queries_count(); q++)
+	{
+		REQUIRE(timeline.connected(q) == expected[q].first);
+		REQUIRE(timeline.components_count(q) == expected[q].second);
+	}
+
+	OfflineDynamicConnectivity twice(2);
+	twice.add_edge(0, 1);
+	twice.add_edge(1, 0);
+	twice.remove_edge(0, 1);
+	twice.remove_edge(0, 1);
+	REQUIRE_THROWS(twice.remove_edge(1, 0));
+}
+
+TEST_CASE("Sparse union-find over 64-bit keys matches a dense one", "[UF]")
+{
+	// Scattered keys standing for the dense ids 0..9999
+	auto key = [](int i)
+	{ return hash_mix(static_cast<std::uint64_t>(i)) | 1; };
+
+	std::mt19937 rng(23);
+	std::uniform_int_distribution<int> pick(0, 9999);
+	SparseUF sparse;
+	PCWQuickUF dense(10000);
+	std::set<int> seen;
+	for (int i = 0; i < 8000; i++)
+	{
+		int p = pick(rng), q = pick(rng);
+		REQUIRE(sparse._union(key(p), key(q)) == dense._union(p, q));
+		seen.insert(p);
+		seen.insert(q);
+	}
+
+	REQUIRE(sparse.size() == static_cast<int>(seen.size()));
+	REQUIRE(sparse.components_count() == dense.components_count() - (10000 - static_cast<int>(seen.size())));
+	for (int v = 0; v < 10000; v++)
+	{
+		int w = (v * 37) % 10000;
+		REQUIRE(sparse.contains(key(v)) == (seen.count(v) == 1));
+		REQUIRE(sparse.connected(key(v), key(w)) == dense.connected(v, w));
+	}
+
+	// Slots stay put as chunks are added
+	int slot = sparse.add(key(*seen.begin()));
+	for (std::uint64_t k = 1; k <= 20000; k++)
+	{
+		sparse.add(k << 40);
+	}
+	REQUIRE(sparse.add(key(*seen.begin())) == slot);
+	REQUIRE(sparse.component_size(1ULL << 40) == 1);
+	REQUIRE(sparse._find(5ULL << 40) == 5ULL << 40);
+	REQUIRE(sparse.bytes() >= static_cast<std::size_t>(sparse.size()) * 12);
+	REQUIRE_THROWS(sparse.add(~0ULL));
+
+	// The reserved key is never found, even where a slot is empty
+	SparseUF fresh;
+	REQUIRE(!fresh.contains(~0ULL));
+	REQUIRE(fresh.component_size(~0ULL) == 1);
+	fresh._union(10, 20);
+	REQUIRE(!fresh.contains(~0ULL));
+	REQUIRE(!fresh.connected(~0ULL, 10));
+	REQUIRE(fresh.component_size(~0ULL) == 1);
+	REQUIRE(fresh.component_size(10) == 2);
+
+	FlatHashSet<int> set;
+	FlatHashMap<std::uint64_t, int> map;
+	REQUIRE(!set.contains(-1));
+	REQUIRE(!set.erase(-1));
+	REQUIRE(map.find(~0ULL) == nullptr);
+	REQUIRE(!map.erase(~0ULL));
+	REQUIRE(map.size() == 0);
+	REQUIRE_THROWS(set.insert(-1));
+	REQUIRE_THROWS(map.insert(~0ULL, 1));
+}
+
+TEST_CASE("Batch unions and parallel frozen queries match single calls", "[UF]")
+{
+	std::mt19937 rng(29);
+	std::uniform_int_distribution<int> pick(0, 49999);
+	std::vector<std::pair<int, int>> unions(40000), queries(60000);
+	for (auto &e : unions)
+	{
+		e = {pick(rng), pick(rng)};
+	}
+	for (auto &e : queries)
+	{
+		e = {pick(rng), pick(rng)};
+	}
+
+	PCWQuickUF reference(50000);
+	for (auto [p, q] : unions)
+	{
+		reference._union(p, q);
+	}
+
+	PackedPCWQuickUF batched(50000);
+	REQUIRE(batched.union_batch(unions) == 50000 - reference.components_count());
+	REQUIRE(batched.components_count() == reference.components_count());
+	REQUIRE(batched.union_batch(unions) == 0);
+
+	UnionFind<LinkByRank, PathSplitting> ranked(50000);
+	ranked.union_batch(unions);
+	for (int threads : {1, 4})
+	{
+		std::vector<char> answers = batched.connected_batch(queries, threads);
+		std::vector<char> ranked_answers = ranked.connected_batch(queries, threads);
+		REQUIRE(answers.size() == queries.size());
+		for (std::size_t i = 0; i < queries.size(); i++)
+		{
+			REQUIRE(static_cast<bool>(answers[i]) == reference.connected(queries[i].first, queries[i].second));
+			REQUIRE(ranked_answers[i] == answers[i]);
+		}
+	}
+}